@@ -0,0 +1,582 @@
+// Google Benchmark suite for the ParameterTraits hot paths.
+//
+//   cmake --build build --target run_benchmarks    (writes build/benchmark_results.json)
+//
+// Covers, per registered trait: parse, validate, serialize and name lookup
+// (single-op latency), the float kernels against the libc calls they
+// replaced, batch vs per-element validation, AoS vs SoA zone scans,
+// perfect-hash vs linear name lookup at 10/100/1000 parameters, whole-config
+// parse and streaming export throughput, the JSON loader against a JSON DOM
+// (when nlohmann_json is installed), sustained journal appends, a
+// multi-thread read/write mix on the concurrent store and cross-process reads
+// over shared memory.
+
+#include <benchmark/benchmark.h>
+
+#if defined(PROPERTYTRAITS_HAVE_NLOHMANN_JSON)
+#include <nlohmann/json.hpp>
+#endif
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "concurrent_parameter_store.h"
+#include "config_parser.h"
+#include "config_stream_parser.h"
+#include "config_writer.h"
+#include "float_format.h"
+#include "float_parse.h"
+#include "json_config.h"
+#include "parameter_array.h"
+#include "parameter_journal.h"
+#include "parameter_store.h"
+#include "parameters.h"
+#include "perfect_hash.h"
+#include "shared_parameter_bus.h"
+
+namespace
+{
+
+constexpr const char* kValueTexts[] = { "42.0", "85.5", "37.25", "99.99", "0.5", "12.125", "73.8", "100" };
+constexpr size_t kValueCount = sizeof(kValueTexts) / sizeof(kValueTexts[0]);
+
+template <typename T>
+T sample_value(size_t i)
+{
+    T v = ParameterTraits<T>::default_v;
+    ParameterTraits<T>::parse(kValueTexts[i % kValueCount], v);
+    return v;
+}
+
+// ---- float kernels vs libc ----
+
+void BM_ParseFloat(benchmark::State& state)
+{
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        float v;
+        benchmark::DoNotOptimize(parse_float(kValueTexts[i++ % kValueCount], v));
+        benchmark::DoNotOptimize(v);
+    }
+}
+BENCHMARK(BM_ParseFloat);
+
+void BM_Strtof(benchmark::State& state)
+{
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        char* end;
+        benchmark::DoNotOptimize(std::strtof(kValueTexts[i++ % kValueCount], &end));
+    }
+}
+BENCHMARK(BM_Strtof);
+
+void BM_FormatFloatFixed(benchmark::State& state)
+{
+    char buf[64];
+    float v = 12.345f;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(format_float_fixed<2>(buf, buf + sizeof(buf), v));
+        v += 0.25f;
+        if (v > 1000.0f) v = 12.345f;
+    }
+}
+BENCHMARK(BM_FormatFloatFixed);
+
+void BM_FormatFloatShortest(benchmark::State& state)
+{
+    char buf[64];
+    float v = 12.345f;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(format_float(buf, buf + sizeof(buf), v));
+        v += 0.25f;
+        if (v > 1000.0f) v = 12.345f;
+    }
+}
+BENCHMARK(BM_FormatFloatShortest);
+
+void BM_Snprintf(benchmark::State& state)
+{
+    char buf[64];
+    float v = 12.345f;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::snprintf(buf, sizeof(buf), "%.2f", v));
+        v += 0.25f;
+        if (v > 1000.0f) v = 12.345f;
+    }
+}
+BENCHMARK(BM_Snprintf);
+
+// ---- per-trait single operations ----
+
+template <typename T>
+void BM_Parse(benchmark::State& state)
+{
+    T v = ParameterTraits<T>::default_v;
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ParameterTraits<T>::parse(kValueTexts[i++ % kValueCount], v));
+    }
+}
+BENCHMARK_TEMPLATE(BM_Parse, TemperatureSetpoint);
+BENCHMARK_TEMPLATE(BM_Parse, HighTemperatureAlarm);
+
+template <typename T>
+void BM_Validate(benchmark::State& state)
+{
+    std::array<T, kValueCount> values;
+    for (size_t i = 0; i < kValueCount; ++i) values[i] = sample_value<T>(i);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ParameterTraits<T>::validate(values[i++ % kValueCount]));
+    }
+}
+BENCHMARK_TEMPLATE(BM_Validate, TemperatureSetpoint);
+BENCHMARK_TEMPLATE(BM_Validate, HighTemperatureAlarm);
+
+template <typename T>
+void BM_Serialize(benchmark::State& state)
+{
+    std::array<T, kValueCount> values;
+    for (size_t i = 0; i < kValueCount; ++i) values[i] = sample_value<T>(i);
+    char buf[ParameterTraits<T>::max_serialized_size];
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ParameterTraits<T>::serialize(values[i++ % kValueCount], buf, sizeof(buf)));
+    }
+}
+BENCHMARK_TEMPLATE(BM_Serialize, TemperatureSetpoint);
+BENCHMARK_TEMPLATE(BM_Serialize, HighTemperatureAlarm);
+
+template <typename T>
+void BM_FindByName(benchmark::State& state)
+{
+    std::string_view name = ParameterTraits<T>::name;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(name);
+        benchmark::DoNotOptimize(Parameters::find(name));
+    }
+}
+BENCHMARK_TEMPLATE(BM_FindByName, TemperatureSetpoint);
+BENCHMARK_TEMPLATE(BM_FindByName, HighTemperatureAlarm);
+
+// ---- batch validation: one setpoint per zone, all valid (full scan) ----
+
+std::vector<TemperatureSetpoint> zone_setpoints(size_t zones)
+{
+    std::vector<TemperatureSetpoint> v(zones);
+    for (size_t i = 0; i < zones; ++i) v[i] = TemperatureSetpoint { 15.0f + static_cast<float>(i % 200) * 0.25f };
+    return v;
+}
+
+void BM_ValidateLoop(benchmark::State& state)
+{
+    const std::vector<TemperatureSetpoint> zones = zone_setpoints(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        size_t i = 0;
+        while (i < zones.size() && ParameterTraits<TemperatureSetpoint>::validate(zones[i])) ++i;
+        benchmark::DoNotOptimize(i);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ValidateLoop)->Arg(1024)->Arg(16384);
+
+void BM_ValidateBatch(benchmark::State& state)
+{
+    const std::vector<TemperatureSetpoint> zones = zone_setpoints(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ParameterTraits<TemperatureSetpoint>::validate_batch(zones.data(), zones.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ValidateBatch)->Arg(1024)->Arg(16384);
+
+void BM_ValidateBatchMask(benchmark::State& state)
+{
+    const std::vector<TemperatureSetpoint> zones = zone_setpoints(static_cast<size_t>(state.range(0)));
+    std::vector<uint64_t> invalid((zones.size() + 63) / 64);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            ParameterTraits<TemperatureSetpoint>::validate_batch(zones.data(), zones.size(), invalid.data()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ValidateBatchMask)->Arg(1024)->Arg(16384);
+
+// ---- one field across many zones: array of structs vs ParameterArray ----
+
+struct ZoneParameters
+{
+    TemperatureSetpoint setpoint;
+    HighTemperatureAlarm alarm;
+};
+
+void BM_ZoneScanArrayOfStructs(benchmark::State& state)
+{
+    std::vector<ZoneParameters> zones(static_cast<size_t>(state.range(0)),
+                                      ZoneParameters { ParameterTraits<TemperatureSetpoint>::default_v,
+                                                       ParameterTraits<HighTemperatureAlarm>::default_v });
+    for (auto _ : state)
+    {
+        size_t i = 0;
+        while (i < zones.size() && ParameterTraits<TemperatureSetpoint>::validate(zones[i].setpoint)) ++i;
+        benchmark::DoNotOptimize(i);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ZoneScanArrayOfStructs)->Arg(16384);
+
+void BM_ZoneScanParameterArray(benchmark::State& state)
+{
+    ParameterArray<TemperatureSetpoint, HighTemperatureAlarm> zones;
+    zones.resize(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(zones.first_invalid<TemperatureSetpoint>());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ZoneScanParameterArray)->Arg(16384);
+
+// ---- name lookup scaling: perfect hash vs linear search ----
+
+template <size_t N>
+struct SyntheticNames
+{
+    SyntheticNames()
+    {
+        storage.reserve(N);
+        for (size_t i = 0; i < N; ++i) storage.push_back("ZoneParameter" + std::to_string(i * 7919 % 100000));
+        for (size_t i = 0; i < N; ++i) views[i] = storage[i];
+    }
+
+    std::vector<std::string> storage;
+    std::array<std::string_view, N> views {};
+};
+
+template <size_t N>
+void BM_NameLookupPerfectHash(benchmark::State& state)
+{
+    static const SyntheticNames<N> names;
+    static const PerfectHash<N> hash(names.views);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(hash.find(names.views[i]));
+        i = (i + 1) % N;
+    }
+}
+BENCHMARK_TEMPLATE(BM_NameLookupPerfectHash, 10);
+BENCHMARK_TEMPLATE(BM_NameLookupPerfectHash, 100);
+BENCHMARK_TEMPLATE(BM_NameLookupPerfectHash, 1000);
+
+template <size_t N>
+void BM_NameLookupLinear(benchmark::State& state)
+{
+    static const SyntheticNames<N> names;
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const std::string_view key = names.views[i];
+        size_t found = N;
+        for (size_t k = 0; k < N; ++k)
+        {
+            if (names.views[k] == key)
+            {
+                found = k;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(found);
+        i = (i + 1) % N;
+    }
+}
+BENCHMARK_TEMPLATE(BM_NameLookupLinear, 10);
+BENCHMARK_TEMPLATE(BM_NameLookupLinear, 100);
+BENCHMARK_TEMPLATE(BM_NameLookupLinear, 1000);
+
+// ---- batch throughput ----
+
+void BM_ParseConfig(benchmark::State& state)
+{
+    std::string text;
+    while (text.size() < static_cast<size_t>(state.range(0)))
+    {
+        text += "TemperatureSetpoint=42.5\nHighTemperatureAlarm = 85.25\n# comment\n";
+    }
+    static ParameterStore<Parameters> store;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parse_config(text, store));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_ParseConfig)->Arg(4 << 10)->Arg(1 << 20);
+
+// 1 MiB of config fed to ConfigStreamParser in range(0)-byte chunks.
+void BM_ParseConfigStream(benchmark::State& state)
+{
+    std::string text;
+    while (text.size() < (1 << 20)) text += "TemperatureSetpoint=42.5\nHighTemperatureAlarm = 85.25\n# comment\n";
+    const size_t chunk = static_cast<size_t>(state.range(0));
+    static ParameterStore<Parameters> store;
+    static ConfigStreamParser<Parameters> parser;
+    auto apply = [](ParameterID id, const void* v) { store.set(id, v); };
+    for (auto _ : state)
+    {
+        for (size_t at = 0; at < text.size(); at += chunk) parser.feed(std::string_view(text).substr(at, chunk), apply);
+        benchmark::DoNotOptimize(parser.finish(apply));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_ParseConfigStream)->Arg(16)->Arg(1500)->Arg(64 << 10);
+
+// About 1 MiB of JSON as upstream tooling emits it: the registered keys
+// among many unknown ones holding nested objects, arrays and strings.
+const std::string& json_config_text()
+{
+    static const std::string text = []
+    {
+        std::string t = "{\n  \"TemperatureSetpoint\": 42.5,\n";
+        for (int i = 0; t.size() < (1 << 20); ++i)
+        {
+            t += "  \"zone" + std::to_string(i) + "\": { \"label\": \"north wing, \\\"B\\\"\", "
+                 "\"limits\": [12.5, 30, -4e2], \"enabled\": true, \"owner\": null },\n";
+        }
+        return t + "  \"HighTemperatureAlarm\": 85.25\n}\n";
+    }();
+    return text;
+}
+
+void BM_LoadJsonConfig(benchmark::State& state)
+{
+    const std::string& text = json_config_text();
+    static ParameterStore<Parameters> store;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(load_json_config(text, store));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_LoadJsonConfig);
+
+#if defined(PROPERTYTRAITS_HAVE_NLOHMANN_JSON)
+// Same document through a DOM: parse everything, then look up each member.
+void BM_LoadJsonConfigDom(benchmark::State& state)
+{
+    const std::string& text = json_config_text();
+    static ParameterStore<Parameters> store;
+    for (auto _ : state)
+    {
+        const nlohmann::json doc = nlohmann::json::parse(text);
+        for (const auto& [key, value] : doc.items())
+        {
+            const ParameterOps* ops = Parameters::find(key);
+            if (!ops || !value.is_number()) continue;
+            const float f = value.get<float>();
+            if (ops->id == ParameterID::TemperatureSetpoint) store.set(TemperatureSetpoint { f });
+            else store.set(HighTemperatureAlarm { f });
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_LoadJsonConfigDom);
+#endif
+
+void BM_SerializeAll(benchmark::State& state)
+{
+    static ParameterStore<Parameters> store;
+    char buf[Parameters::max_serialized_size];
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        for (const ParameterOps& ops : Parameters::table)
+        {
+            int n = store.serialize(ops.id, buf, sizeof(buf));
+            benchmark::DoNotOptimize(buf);
+            bytes += static_cast<size_t>(n);
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * Parameters::size));
+}
+BENCHMARK(BM_SerializeAll);
+
+// Whole store as name=value text, range(0) copies per iteration into one
+// buffer sink; then one export per iteration to /dev/null through writev.
+void BM_StreamConfigBuffer(benchmark::State& state)
+{
+    static ParameterStore<Parameters> store;
+    static char out[Parameters::max_config_size * 1024];
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        BufferConfigSink sink(out, sizeof(out));
+        for (int64_t i = 0; i < state.range(0); ++i) bytes += static_cast<size_t>(stream_config(store, sink));
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_StreamConfigBuffer)->Arg(1)->Arg(1024);
+
+void BM_StreamConfigFd(benchmark::State& state)
+{
+    static ParameterStore<Parameters> store;
+    const int fd = open("/dev/null", O_WRONLY);
+    FdConfigSink<4096, 1> sink(fd);
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        bytes += static_cast<size_t>(stream_config(store, sink));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    close(fd);
+}
+BENCHMARK(BM_StreamConfigFd);
+
+// ---- journal ----
+
+// Sustained appends with a group commit (one fdatasync) every range(0) records.
+void BM_JournalAppend(benchmark::State& state)
+{
+    static ParameterJournal<Parameters> journal;
+    char base[] = "/tmp/PropertyTraitsBench.XXXXXX";
+    const int fd = ::mkstemp(base);
+    if (fd < 0 || !journal.open(base))
+    {
+        state.SkipWithError("cannot create journal");
+        return;
+    }
+
+    const size_t group = static_cast<size_t>(state.range(0));
+    size_t pending = 0;
+    float v = 10.0f;
+    for (auto _ : state)
+    {
+        journal.append(TemperatureSetpoint{ v });
+        v = v < 90.0f ? v + 0.5f : 10.0f;
+        if (++pending == group)
+        {
+            journal.commit();
+            pending = 0;
+        }
+    }
+    journal.commit();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+
+    journal.close();
+    ::close(fd);
+    char path[sizeof(base) + 16];
+    std::snprintf(path, sizeof(path), "%s.journal", base);
+    ::unlink(path);
+    ::unlink(base);
+}
+BENCHMARK(BM_JournalAppend)->Arg(64)->Arg(1024)->Arg(16384);
+
+// ---- concurrent read/write mix ----
+
+ConcurrentParameterStore<Parameters> g_live;
+
+// Thread 0 publishes new values; every other thread is a reader. Reported
+// time per iteration on reader threads is the read latency under contention.
+void BM_ConcurrentReadWriteMix(benchmark::State& state)
+{
+    const bool writer = state.thread_index() == 0 && state.threads() > 1;
+    float v = 10.0f;
+    for (auto _ : state)
+    {
+        if (writer)
+        {
+            g_live.set(TemperatureSetpoint{ v });
+            v = v < 90.0f ? v + 0.5f : 10.0f;
+        }
+        else
+        {
+            benchmark::DoNotOptimize(g_live.get<TemperatureSetpoint>());
+        }
+    }
+}
+BENCHMARK(BM_ConcurrentReadWriteMix)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+
+// ---- shared-memory bus: read latency, idle and with a writer process ----
+
+// Arg 1 forks a child that rewrites the setpoint in a loop while we read.
+void BM_SharedBusRead(benchmark::State& state)
+{
+    constexpr const char* kName = "/PropertyTraitsBench.bus";
+    SharedParameterBus<Parameters> bus;
+    if (!bus.create(kName))
+    {
+        state.SkipWithError("shm_open failed");
+        return;
+    }
+    pid_t writer = -1;
+    if (state.range(0))
+    {
+        writer = fork();
+        if (writer == 0)
+        {
+            for (float v = 10.0f;; v = v < 90.0f ? v + 0.5f : 10.0f) bus.set(TemperatureSetpoint { v });
+        }
+    }
+
+    SharedParameterBus<Parameters> reader;
+    reader.attach(kName);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(reader.get<TemperatureSetpoint>());
+    }
+
+    if (writer > 0)
+    {
+        kill(writer, SIGKILL);
+        waitpid(writer, nullptr, 0);
+    }
+    SharedParameterBus<Parameters>::unlink(kName);
+}
+BENCHMARK(BM_SharedBusRead)->Arg(0)->Arg(1)->UseRealTime();
+
+void BM_SharedBusVersionPoll(benchmark::State& state)
+{
+    constexpr const char* kName = "/PropertyTraitsBench.poll";
+    SharedParameterBus<Parameters> bus;
+    if (!bus.create(kName))
+    {
+        state.SkipWithError("shm_open failed");
+        return;
+    }
+    uint32_t seen = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bus.changed(ParameterID::TemperatureSetpoint, seen));
+    }
+    SharedParameterBus<Parameters>::unlink(kName);
+}
+BENCHMARK(BM_SharedBusVersionPoll);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,178 @@
+#pragma once
+
+// Compact binary encoding for parameters.
+//
+// Values are encoded from ParameterTraits<T>::UnderlyingType as fixed-width
+// little-endian (store_le / load_le, little_endian.h). A single parameter on
+// the wire is
+//
+//   u16 ParameterID | u16 schema version | binary_size payload bytes
+//
+// and a whole-store snapshot is
+//
+//   u32 magic "PTS1" | u32 layout fingerprint | u32 block size | block image
+//
+// where the block image is the ParameterStore layout with every value in
+// little-endian. On little-endian hosts whose parameter structs are exactly
+// their UnderlyingType, that image is the in-memory block, so encoding and
+// decoding a snapshot is a straight memcpy.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "little_endian.h"
+#include "parameter_registry.h"
+#include "parameter_store.h"
+
+inline constexpr size_t kBinaryHeaderSize = 2 * sizeof(uint16_t);
+inline constexpr size_t kSnapshotHeaderSize = 3 * sizeof(uint32_t);
+inline constexpr uint32_t kSnapshotMagic = 0x31535450;   // "PTS1" little-endian
+
+// Encodes one parameter with its header; returns bytes written, 0 if it does not fit.
+template <typename Registry>
+size_t encode_binary(const ParameterStore<Registry>& store, ParameterID id, unsigned char* out, size_t n)
+{
+    const ParameterOps* ops = Registry::ops(id);
+    if (!ops || n < kBinaryHeaderSize + ops->binary_size) return 0;
+    store_le(static_cast<uint16_t>(id), out);
+    store_le(ops->schema_version, out + sizeof(uint16_t));
+    return kBinaryHeaderSize + ops->serialize_binary(store.get(id), out + kBinaryHeaderSize, n - kBinaryHeaderSize);
+}
+
+// Decodes one header + payload into the store (through parse_binary, so the
+// value is validated); returns bytes consumed, 0 on unknown ID, schema
+// mismatch, short input or a rejected value.
+template <typename Registry>
+size_t decode_binary(ParameterStore<Registry>& store, const unsigned char* in, size_t n)
+{
+    if (n < kBinaryHeaderSize) return 0;
+    const ParameterID id = static_cast<ParameterID>(load_le<uint16_t>(in));
+    const ParameterOps* ops = Registry::ops(id);
+    if (!ops || load_le<uint16_t>(in + sizeof(uint16_t)) != ops->schema_version) return 0;
+    if (n < kBinaryHeaderSize + ops->binary_size) return 0;
+
+    alignas(std::max_align_t) unsigned char value[ParameterStore<Registry>::size_bytes];
+    std::memcpy(value, store.get(id), ops->size);
+    if (!ops->parse_binary(in + kBinaryHeaderSize, ops->binary_size, value)) return 0;
+    store.set(id, value);
+    return kBinaryHeaderSize + ops->binary_size;
+}
+
+// Encodes every dirty parameter back to back, in ID order, as decode_binary
+// records; returns bytes written, 0 if nothing is dirty or it does not all fit.
+template <typename Registry>
+size_t encode_dirty(const ParameterStore<Registry>& store, unsigned char* out, size_t n)
+{
+    size_t at = 0;
+    bool fits = true;
+    store.for_each_dirty([&](ParameterID id)
+    {
+        const size_t w = fits ? encode_binary(store, id, out + at, n - at) : 0;
+        fits = w != 0;
+        at += w;
+    });
+    return fits ? at : 0;
+}
+
+namespace detail
+{
+
+// Identifies the snapshot layout: IDs, names, sizes, offsets and schema versions.
+template <typename Registry>
+constexpr uint32_t snapshot_fingerprint()
+{
+    uint64_t h = fnv1a("ParameterStore");
+    for (size_t i = 0; i < Registry::size; ++i)
+    {
+        const ParameterOps& ops = Registry::table[i];
+        h = (h ^ fnv1a(ops.name)) * 0x100000001b3ULL;
+        h = (h ^ ops.size ^ (ops.binary_size << 16) ^ (uint64_t(ops.schema_version) << 32)) * 0x100000001b3ULL;
+        h = (h ^ ParameterStore<Registry>::offsets[i]) * 0x100000001b3ULL;
+    }
+    return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+template <typename Registry>
+constexpr bool snapshot_is_memory_image()
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return false;
+#else
+    for (const ParameterOps& ops : Registry::table)
+    {
+        if (ops.size != ops.binary_size) return false;
+    }
+    return true;
+#endif
+}
+
+} // namespace detail
+
+template <typename Registry>
+inline constexpr size_t kSnapshotSize = kSnapshotHeaderSize + ParameterStore<Registry>::size_bytes;
+
+// Writes the whole store; returns bytes written, 0 if n < kSnapshotSize<Registry>.
+template <typename Registry>
+size_t encode_snapshot(const ParameterStore<Registry>& store, unsigned char* out, size_t n)
+{
+    using Store = ParameterStore<Registry>;
+    if (n < kSnapshotSize<Registry>) return 0;
+
+    store_le(kSnapshotMagic, out);
+    store_le(detail::snapshot_fingerprint<Registry>(), out + 4);
+    store_le(static_cast<uint32_t>(Store::size_bytes), out + 8);
+    unsigned char* block = out + kSnapshotHeaderSize;
+
+    if constexpr (detail::snapshot_is_memory_image<Registry>())
+    {
+        std::memcpy(block, store.data(), Store::size_bytes);
+    }
+    else
+    {
+        std::memset(block, 0, Store::size_bytes);
+        for (size_t i = 0; i < Registry::size; ++i)
+        {
+            const ParameterOps& ops = Registry::table[i];
+            ops.serialize_binary(store.data() + Store::offsets[i], block + Store::offsets[i], ops.binary_size);
+        }
+    }
+    return kSnapshotSize<Registry>;
+}
+
+// Replaces the whole store from a snapshot if the header matches and every
+// value passes its trait's validate; otherwise the store is left unchanged.
+template <typename Registry>
+bool decode_snapshot(ParameterStore<Registry>& store, const unsigned char* in, size_t n)
+{
+    using Store = ParameterStore<Registry>;
+    if (n < kSnapshotSize<Registry>
+        || load_le<uint32_t>(in) != kSnapshotMagic
+        || load_le<uint32_t>(in + 4) != detail::snapshot_fingerprint<Registry>()
+        || load_le<uint32_t>(in + 8) != Store::size_bytes)
+    {
+        return false;
+    }
+    const unsigned char* block = in + kSnapshotHeaderSize;
+
+    Store candidate;
+    if constexpr (detail::snapshot_is_memory_image<Registry>())
+    {
+        std::memcpy(candidate.data(), block, Store::size_bytes);
+        for (size_t i = 0; i < Registry::size; ++i)
+        {
+            if (!Registry::table[i].validate(candidate.data() + Store::offsets[i])) return false;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < Registry::size; ++i)
+        {
+            const ParameterOps& ops = Registry::table[i];
+            if (!ops.parse_binary(block + Store::offsets[i], ops.binary_size, candidate.data() + Store::offsets[i])) return false;
+        }
+    }
+    std::memcpy(store.data(), candidate.data(), Store::size_bytes);
+    return true;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// Cache line size assumed for alignment and false-sharing padding throughout
+// (stores, concurrent slots, stats slots, mapped and shared-memory layouts).
+
+#include <cstddef>
+
+inline constexpr size_t kCacheLineSize = 64;
@@ -0,0 +1,258 @@
+#pragma once
+
+// Parameter store for one-or-more writer threads and many reader threads.
+//
+// Every parameter gets its own cache-line-sized slot so updates to one never
+// invalidate readers of another. Parameters that fit in a machine word are
+// published with a single atomic store and read with a single atomic load
+// (wait-free). Larger ones sit behind a per-parameter seqlock: readers copy
+// the payload and retry only if a write overlapped, so they never block a
+// writer and never take a lock themselves. Writers run
+// ParameterTraits<T>::validate before anything becomes visible.
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "parameter_registry.h"
+#include "parameter_store.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace detail
+{
+
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+template <typename T, bool = (sizeof(T) <= sizeof(uint64_t))>
+class alignas(kCacheLineSize) ConcurrentSlot
+{
+    using Word = std::conditional_t<sizeof(T) <= sizeof(uint32_t), uint32_t, uint64_t>;
+
+public:
+    T load() const
+    {
+        const Word w = word_.load(std::memory_order_acquire);
+        T v;
+        std::memcpy(&v, &w, sizeof(T));
+        return v;
+    }
+
+    void store(const T& v)
+    {
+        Word w = 0;
+        std::memcpy(&w, &v, sizeof(T));
+        word_.store(w, std::memory_order_release);
+    }
+
+private:
+    std::atomic<Word> word_ { 0 };
+};
+
+// Seqlock over Words atomic words: an odd sequence number means a write is
+// in progress. Readers copy and retry if a write overlapped; writers exclude
+// each other by moving the sequence from even to odd.
+template <size_t Words>
+class SeqLockWords
+{
+public:
+    // Copies words [first, last) as they were between two writes.
+    void read(uint64_t* out, size_t first = 0, size_t last = Words) const
+    {
+        for (;;)
+        {
+            const uint32_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                cpu_relax();
+                continue;
+            }
+            for (size_t i = first; i < last; ++i) out[i - first] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) return;
+        }
+    }
+
+    // Publishes in[0, Words).
+    void write(const uint64_t* in)
+    {
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if (seq & 1)
+            {
+                cpu_relax();
+                seq = seq_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (seq_.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) break;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < Words; ++i) words_[i].store(in[i], std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+private:
+    std::atomic<uint32_t> seq_ { 0 };
+    std::atomic<uint64_t> words_[Words] {};
+};
+
+template <typename T>
+class alignas(kCacheLineSize) ConcurrentSlot<T, false>
+{
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    T load() const
+    {
+        uint64_t buf[kWords];
+        lock_.read(buf);
+        T v;
+        std::memcpy(&v, buf, sizeof(T));
+        return v;
+    }
+
+    void store(const T& v)
+    {
+        uint64_t buf[kWords] {};
+        std::memcpy(buf, &v, sizeof(T));
+        lock_.write(buf);
+    }
+
+private:
+    SeqLockWords<kWords> lock_;
+};
+
+} // namespace detail
+
+template <typename Registry>
+class ConcurrentParameterStore;
+
+template <typename... Ts>
+class ConcurrentParameterStore<ParameterRegistry<Ts...>>
+{
+public:
+    using Registry = ParameterRegistry<Ts...>;
+
+    static_assert((std::is_trivially_copyable_v<Ts> && ...),
+                  "stored parameters must be trivially copyable");
+
+    ConcurrentParameterStore()
+    {
+        reset();
+    }
+
+    // Publishes ParameterTraits<T>::default_v for every parameter.
+    void reset()
+    {
+        (slot<Ts>().store(ParameterTraits<Ts>::default_v), ...);
+    }
+
+    template <typename T>
+    T get() const
+    {
+        return slot<T>().load();
+    }
+
+    // Publishes v if ParameterTraits<T>::validate accepts it.
+    template <typename T>
+    bool set(const T& v)
+    {
+        if (!ParameterTraits<T>::validate(v)) return false;
+        slot<T>().store(v);
+        return true;
+    }
+
+    // ID-based access; `out` / `value` point at the struct registered for id.
+    bool get(ParameterID id, void* out) const
+    {
+        if (!Registry::contains_id(id)) return false;
+        getters[static_cast<size_t>(id)](*this, out);
+        return true;
+    }
+
+    bool set(ParameterID id, const void* value)
+    {
+        return Registry::contains_id(id) && setters[static_cast<size_t>(id)](*this, value);
+    }
+
+    // Parses all of `in` on top of the current value and publishes it if it
+    // validates.
+    ParameterResult parse(ParameterID id, std::string_view in)
+    {
+        if (!Registry::contains_id(id)) return { ParameterError::UnknownParameter };
+        return parsers[static_cast<size_t>(id)](*this, in);
+    }
+
+    ParameterResult parse(ParameterID id, const char* in)
+    {
+        return in ? parse(id, std::string_view(in)) : ParameterResult { ParameterError::Empty };
+    }
+
+private:
+    template <typename T>
+    detail::ConcurrentSlot<T>& slot()
+    {
+        return std::get<Registry::template index_of<T>()>(slots_);
+    }
+
+    template <typename T>
+    const detail::ConcurrentSlot<T>& slot() const
+    {
+        return std::get<Registry::template index_of<T>()>(slots_);
+    }
+
+    template <typename T>
+    static void get_erased(const ConcurrentParameterStore& s, void* out)
+    {
+        *static_cast<T*>(out) = s.get<T>();
+    }
+
+    template <typename T>
+    static bool set_erased(ConcurrentParameterStore& s, const void* value)
+    {
+        return s.set(*static_cast<const T*>(value));
+    }
+
+    template <typename T>
+    static ParameterResult parse_erased(ConcurrentParameterStore& s, std::string_view in)
+    {
+        T v = s.get<T>();
+        const ParameterResult r = ParameterTraits<T>::parse(in, v);
+        if (r) s.slot<T>().store(v);
+        return r;
+    }
+
+    // Dispatch tables indexed by ParameterID.
+    template <typename Fn, typename... Entries>
+    static constexpr std::array<Fn, Registry::size> by_id(Entries... entries)
+    {
+        std::array<Fn, Registry::size> t {};
+        const ParameterID ids[] = { ParameterTraits<Ts>::id... };
+        const Fn fns[] = { entries... };
+        for (size_t i = 0; i < Registry::size; ++i) t[static_cast<size_t>(ids[i])] = fns[i];
+        return t;
+    }
+
+    using Getter = void (*)(const ConcurrentParameterStore&, void*);
+    using Setter = bool (*)(ConcurrentParameterStore&, const void*);
+    using Parser = ParameterResult (*)(ConcurrentParameterStore&, std::string_view);
+
+    static constexpr std::array<Getter, Registry::size> getters = by_id<Getter>(&get_erased<Ts>...);
+    static constexpr std::array<Setter, Registry::size> setters = by_id<Setter>(&set_erased<Ts>...);
+    static constexpr std::array<Parser, Registry::size> parsers = by_id<Parser>(&parse_erased<Ts>...);
+
+    std::tuple<detail::ConcurrentSlot<Ts>...> slots_;
+};
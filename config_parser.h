@@ -0,0 +1,219 @@
+#pragma once
+
+// Single-pass loader for name=value configuration text.
+//
+// parse_config() walks the buffer once: each line's first '=' and its end
+// come out of one SIMD delimiter scan, names resolve through the registry's
+// perfect hash and values go straight from the buffer to the store's ID-based
+// parse (and so through ParameterTraits<T>::parse and validate) without
+// being copied. Blank lines and lines starting with '#' are skipped; spaces,
+// tabs and a trailing '\r' are trimmed. Failures are reported per line
+// through a callback, nothing allocates. write_config() emits the same
+// format, for every parameter or only those marked dirty in the store;
+// ConfigStreamParser (config_stream_parser.h) reads it when it arrives in
+// pieces.
+//
+//   size_t applied = parse_config(text, store, [](const ConfigLineError& e) { ... }).applied;
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#include "parameter_error.h"
+#include "parameter_registry.h"
+#include "simd_scan.h"
+
+enum class ConfigError : uint8_t
+{
+    None,
+    MissingEquals,      // line has no '='
+    UnknownName,        // name is not registered
+    InvalidValue,       // trait parse or validate rejected the value
+    ValueTooLong,       // ConfigStreamParser: value longer than its MaxValue, however the chunks split
+    Syntax              // load_json_config: the document is not a well-formed JSON object
+};
+
+inline constexpr const char* to_string(ConfigError e)
+{
+    switch (e)
+    {
+    case ConfigError::None: return "none";
+    case ConfigError::MissingEquals: return "missing '='";
+    case ConfigError::UnknownName: return "unknown name";
+    case ConfigError::InvalidValue: return "invalid value";
+    case ConfigError::ValueTooLong: return "value too long";
+    case ConfigError::Syntax: return "syntax error";
+    }
+    return "unknown";
+}
+
+struct ConfigLineError
+{
+    size_t line;        // 1-based
+    size_t offset;      // byte offset in the buffer of the offending token or character
+    ConfigError error;
+    ParameterResult cause;  // InvalidValue: what the trait rejected, and why; empty otherwise
+};
+
+struct ConfigParseResult
+{
+    size_t applied;     // lines whose value was stored
+    size_t failed;      // lines reported to the error callback
+};
+
+namespace detail
+{
+
+inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline std::string_view trim(std::string_view s)
+{
+    size_t b = 0, e = s.size();
+    while (b < e && is_blank(s[b])) ++b;
+    while (e > b && is_blank(s[e - 1])) --e;
+    return s.substr(b, e - b);
+}
+
+// End of the line starting at p (its '\n', or end), found in the same scan
+// as the line's first '=': *eq is set to that '=', or to the line end if
+// there is none.
+inline const char* scan_line(const char* p, const char* end, const char*& eq)
+{
+    const char* hit = find_any<'\n', '='>(p, end);
+    if (hit == end || *hit == '\n')
+    {
+        eq = hit;
+        return hit;
+    }
+    eq = hit;
+    return find_char(hit + 1, end, '\n');
+}
+
+// Handles one trimmed line whose first '=' is at eq (or line end if none):
+// skips blanks and comments, resolves the name and hands the trimmed value to
+// parse(ops, value), unless it is longer than max_value. Returns true if the
+// value was accepted; otherwise reports through fail(at, error, cause) unless
+// the line was skipped.
+template <typename Registry, typename Parse, typename Fail>
+bool config_line(std::string_view line, const char* eq, Parse&& parse, Fail&& fail, size_t max_value = ~size_t { 0 })
+{
+    if (line.empty() || line.front() == '#') return false;
+
+    const char* const line_end = line.data() + line.size();
+    if (eq >= line_end)
+    {
+        fail(line.data(), ConfigError::MissingEquals, ParameterResult {});
+        return false;
+    }
+
+    const std::string_view name = trim(std::string_view(line.data(), static_cast<size_t>(eq - line.data())));
+    const std::string_view value = trim(std::string_view(eq + 1, static_cast<size_t>(line_end - eq - 1)));
+
+    const ParameterOps* ops = Registry::find(name);
+    if (!ops)
+    {
+        fail(line.data(), ConfigError::UnknownName, ParameterResult {});
+        return false;
+    }
+    if (value.size() > max_value)
+    {
+        fail(value.data(), ConfigError::ValueTooLong, ParameterResult {});
+        return false;
+    }
+    const ParameterResult parsed = parse(*ops, value);
+    if (!parsed)
+    {
+        fail(value.data() + parsed.offset, ConfigError::InvalidValue, parsed);
+        return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+template <typename Store, typename OnError>
+ConfigParseResult parse_config(std::string_view buffer, Store& store, OnError&& on_error)
+{
+    using Registry = typename Store::Registry;
+
+    ConfigParseResult result { 0, 0 };
+    const char* const begin = buffer.data();
+    const char* const end = begin + buffer.size();
+    size_t line_no = 0;
+
+    auto parse = [&](const ParameterOps& ops, std::string_view value)
+    {
+        return store.parse(ops.id, value);
+    };
+    auto fail = [&](const char* at, ConfigError error, ParameterResult cause)
+    {
+        ++result.failed;
+        on_error(ConfigLineError { line_no, static_cast<size_t>(at - begin), error, cause });
+    };
+
+    for (const char* p = begin; p < end;)
+    {
+        ++line_no;
+        const char* eq;
+        const char* eol = detail::scan_line(p, end, eq);
+        const std::string_view line = detail::trim(std::string_view(p, static_cast<size_t>(eol - p)));
+        p = eol < end ? eol + 1 : end;
+
+        if (detail::config_line<Registry>(line, eq, parse, fail)) ++result.applied;
+    }
+    return result;
+}
+
+template <typename Store>
+ConfigParseResult parse_config(std::string_view buffer, Store& store)
+{
+    return parse_config(buffer, store, [](const ConfigLineError&) {});
+}
+
+// Writes "name=value" lines that parse_config reads back, for every parameter
+// or only the dirty ones, plus a NUL terminator. Returns the text length, or
+// -1 if it does not fit in n bytes. Every line checks its own room: values
+// written through data() skip validate and may serialize past the trait's
+// max_serialized_size, so a buffer of Registry::max_config_size is not
+// enough to prove that they fit.
+template <typename Store>
+int write_config(const Store& store, char* out, size_t n, bool dirty_only = false)
+{
+    using Registry = typename Store::Registry;
+
+    size_t at = 0;
+    bool fits = n > 0;
+    auto write_line = [&](ParameterID id)
+    {
+        const ParameterOps& ops = Registry::table[static_cast<size_t>(id)];
+        if (!fits || n - at < ops.name.size() + 2)
+        {
+            fits = false;
+            return;
+        }
+        std::memcpy(out + at, ops.name.data(), ops.name.size());
+        at += ops.name.size();
+        out[at++] = '=';
+        const int len = ops.serialize(store.get(id), out + at, n - at);
+        if (len < 0 || n - at - static_cast<size_t>(len) < 2)
+        {
+            fits = false;
+            return;
+        }
+        at += static_cast<size_t>(len);
+        out[at++] = '\n';
+    };
+
+    if (dirty_only)
+    {
+        store.for_each_dirty(write_line);
+    }
+    else
+    {
+        for (size_t i = 0; i < Registry::size; ++i) write_line(static_cast<ParameterID>(i));
+    }
+    if (!fits) return -1;
+    out[at] = '\0';
+    return static_cast<int>(at);
+}
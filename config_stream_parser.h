@@ -0,0 +1,287 @@
+#pragma once
+
+// Push-style, resumable parser for name=value configuration text.
+//
+// ConfigStreamParser accepts the text in arbitrary chunks, split anywhere,
+// and calls on_update(ParameterID, const void* value) as soon as the line
+// holding that value is complete. Lines that lie wholly inside one chunk go
+// through the same line handling as parse_config, straight from the
+// caller's bytes. Only a line cut by a chunk boundary is carried over, and
+// then only its current token: the name until its '=' resolves it to a
+// ParameterID, after that the value. The state is a fixed-size member (one
+// token buffer, one value scratch), so nothing allocates and a parser can be
+// static.
+//
+// Values are parsed through ParameterTraits<T>::parse into a copy of
+// ParameterTraits<T>::default_v, so on_update only ever sees values that
+// passed validate; apply them with store.set(id, value). A value longer than
+// MaxValue (after trimming) is ValueTooLong whether or not a chunk boundary
+// cut it. Errors carry the byte offset in the stream since the last finish().
+//
+//   static ConfigStreamParser<Parameters> parser;
+//   parser.feed(chunk, [&](ParameterID id, const void* v) { store.set(id, v); });
+//   ...
+//   parser.finish(on_update);     // end of stream: a last line without '\n'
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#include "config_parser.h"
+#include "parameter_error.h"
+#include "parameter_registry.h"
+#include "simd_scan.h"
+
+template <typename Registry, size_t MaxValue = 64>
+class ConfigStreamParser;
+
+template <typename... Ts, size_t MaxValue>
+class ConfigStreamParser<ParameterRegistry<Ts...>, MaxValue>
+{
+public:
+    using Registry = ParameterRegistry<Ts...>;
+
+    // A longer name cannot be registered, so never needs carrying over.
+    static constexpr size_t kMaxName = []
+    {
+        size_t n = 0;
+        for (const ParameterOps& ops : Registry::table) n = std::max(n, ops.name.size());
+        return n;
+    }();
+    static constexpr size_t kTokenCapacity = std::max(kMaxName, MaxValue);
+
+    // Parses every complete line in chunk; a trailing partial line is kept
+    // for the next call.
+    template <typename OnUpdate, typename OnError>
+    ConfigParseResult feed(std::string_view chunk, OnUpdate&& on_update, OnError&& on_error)
+    {
+        ConfigParseResult result { 0, 0 };
+        const char* const begin = chunk.data();
+        const char* const end = begin + chunk.size();
+
+        auto parse = [&](const ParameterOps& ops, std::string_view value)
+        {
+            return emit(ops, value, on_update);
+        };
+        auto fail = [&](const char* at, ConfigError error, ParameterResult cause)
+        {
+            ++result.failed;
+            on_error(ConfigLineError { line_, offset_ + static_cast<size_t>(at - begin), error, cause });
+        };
+
+        for (const char* p = begin; p < end;)
+        {
+            const char* eq;
+            const char* eol = detail::scan_line(p, end, eq);
+            if (phase_ == Phase::LineStart && eol < end)
+            {
+                // Whole line in this chunk: no copy.
+                const std::string_view line = detail::trim(std::string_view(p, static_cast<size_t>(eol - p)));
+                if (detail::config_line<Registry>(line, eq, parse, fail, MaxValue)) ++result.applied;
+            }
+            else
+            {
+                consume(p, eol, offset_ + static_cast<size_t>(p - begin));
+                if (eol == end) break;
+                finish_line(result, on_update, on_error);
+            }
+            ++line_;
+            p = eol + 1;
+        }
+        offset_ += chunk.size();
+        return result;
+    }
+
+    template <typename OnUpdate>
+    ConfigParseResult feed(std::string_view chunk, OnUpdate&& on_update)
+    {
+        return feed(chunk, on_update, [](const ConfigLineError&) {});
+    }
+
+    // Ends the stream: completes a last line that had no '\n', then resets.
+    template <typename OnUpdate, typename OnError>
+    ConfigParseResult finish(OnUpdate&& on_update, OnError&& on_error)
+    {
+        ConfigParseResult result { 0, 0 };
+        if (phase_ != Phase::LineStart) finish_line(result, on_update, on_error);
+        reset();
+        return result;
+    }
+
+    template <typename OnUpdate>
+    ConfigParseResult finish(OnUpdate&& on_update)
+    {
+        return finish(on_update, [](const ConfigLineError&) {});
+    }
+
+    // Drops any partial line and starts a new stream.
+    void reset()
+    {
+        start_line();
+        line_ = 1;
+        offset_ = 0;
+    }
+
+    // 1-based line the next byte belongs to.
+    size_t line() const { return line_; }
+
+    // Bytes fed since the stream started.
+    size_t offset() const { return offset_; }
+
+private:
+    enum class Phase : uint8_t
+    {
+        LineStart,      // only blanks so far
+        Name,           // carrying the name, no '=' yet
+        ValueStart,     // name resolved, blanks after '='
+        Value,          // carrying the value
+        Skip            // comment, or a line already known to fail
+    };
+
+    // Advances the partial-line state over [p, e), which starts at stream
+    // offset pos and holds no '\n'.
+    void consume(const char* p, const char* e, size_t pos)
+    {
+        const char* const start = p;
+        auto at = [&](const char* q) { return pos + static_cast<size_t>(q - start); };
+        while (p < e)
+        {
+            switch (phase_)
+            {
+            case Phase::LineStart:
+                while (p < e && detail::is_blank(*p)) ++p;
+                if (p == e) return;
+                line_offset_ = at(p);
+                phase_ = *p == '#' ? Phase::Skip : Phase::Name;
+                break;
+            case Phase::Name:
+            {
+                const char* eq = find_char(p, e, '=');
+                append(p, eq);
+                if (eq == e) return;
+                const ParameterOps* ops = overflow_ ? nullptr : Registry::find(detail::trim(token()));
+                if (!ops)
+                {
+                    error_ = ConfigError::UnknownName;
+                    phase_ = Phase::Skip;
+                    return;
+                }
+                ops_ = ops;
+                clear_token();
+                phase_ = Phase::ValueStart;
+                p = eq + 1;
+                value_offset_ = at(p);
+                break;
+            }
+            case Phase::ValueStart:
+                while (p < e && detail::is_blank(*p)) ++p;
+                if (p == e) return;
+                value_offset_ = at(p);
+                phase_ = Phase::Value;
+                break;
+            case Phase::Value:
+                append(p, e);
+                return;
+            case Phase::Skip:
+                return;
+            }
+        }
+    }
+
+    template <typename OnUpdate, typename OnError>
+    void finish_line(ConfigParseResult& result, OnUpdate& on_update, OnError& on_error)
+    {
+        auto fail = [&](size_t offset, ConfigError error, ParameterResult cause = {})
+        {
+            ++result.failed;
+            on_error(ConfigLineError { line_, offset, error, cause });
+        };
+
+        switch (phase_)
+        {
+        case Phase::LineStart:
+            break;
+        case Phase::Name:
+            fail(line_offset_, ConfigError::MissingEquals);
+            break;
+        case Phase::Skip:
+            if (error_ != ConfigError::None) fail(line_offset_, error_);
+            break;
+        case Phase::ValueStart:
+        case Phase::Value:
+        {
+            const std::string_view value = detail::trim(token());
+            if (overflow_ || value.size() > MaxValue)
+            {
+                fail(value_offset_, ConfigError::ValueTooLong);
+                break;
+            }
+            const ParameterResult parsed = emit(*ops_, value, on_update);
+            if (parsed) ++result.applied;
+            else fail(value_offset_ + parsed.offset, ConfigError::InvalidValue, parsed);
+            break;
+        }
+        }
+        start_line();
+    }
+
+    template <typename OnUpdate>
+    ParameterResult emit(const ParameterOps& ops, std::string_view value, OnUpdate& on_update)
+    {
+        std::memcpy(scratch_, ops.default_value, ops.size);
+        const ParameterResult r = ops.parse(value, scratch_);
+        if (r) on_update(ops.id, static_cast<const void*>(scratch_));
+        return r;
+    }
+
+    // Copies [p, q) onto the token. Blanks past the capacity are dropped,
+    // since trimming would drop them anyway; anything after them overflows.
+    void append(const char* p, const char* q)
+    {
+        const size_t n = static_cast<size_t>(q - p);
+        if (!dropped_ && n <= kTokenCapacity - token_len_)
+        {
+            std::memcpy(token_ + token_len_, p, n);
+            token_len_ += n;
+            return;
+        }
+        for (; p < q; ++p)
+        {
+            if (!dropped_ && token_len_ < kTokenCapacity) token_[token_len_++] = *p;
+            else if (detail::is_blank(*p)) dropped_ = true;
+            else overflow_ = true;
+        }
+    }
+
+    std::string_view token() const { return std::string_view(token_, token_len_); }
+
+    void clear_token()
+    {
+        token_len_ = 0;
+        overflow_ = false;
+        dropped_ = false;
+    }
+
+    void start_line()
+    {
+        clear_token();
+        phase_ = Phase::LineStart;
+        error_ = ConfigError::None;
+        ops_ = nullptr;
+    }
+
+    alignas(Ts...) unsigned char scratch_[std::max({ sizeof(Ts)... })];
+    char token_[kTokenCapacity];
+    size_t token_len_ = 0;
+    size_t line_ = 1;
+    size_t offset_ = 0;
+    size_t line_offset_ = 0;
+    size_t value_offset_ = 0;
+    const ParameterOps* ops_ = nullptr;
+    Phase phase_ = Phase::LineStart;
+    ConfigError error_ = ConfigError::None;
+    bool overflow_ = false;
+    bool dropped_ = false;
+};
@@ -0,0 +1,205 @@
+#pragma once
+
+// Streaming name=value writer for a whole store (POSIX).
+//
+// stream_config() renders the "name=value\n" lines parse_config reads back
+// straight into chunks handed out by a sink: names are copied from the
+// registry's static strings and values serialized in place, with no
+// per-parameter temporary and no allocation. A chunk is handed back to the
+// sink once the next line does not fit in it; each trait's
+// max_serialized_size bounds a line at compile time, so lines that are sure
+// to fit skip the writer's own room checks. A sink provides
+//
+//   char* chunk(size_t& n)    next region to render into, n bytes long;
+//                             nullptr on error
+//   bool emit(size_t used)    the first `used` bytes of that region are done
+//   bool flush()              push out everything emitted so far
+//
+// BufferConfigSink renders into one caller-supplied buffer. FdConfigSink
+// owns Chunks buffers of ChunkSize bytes and hands all the filled ones to a
+// single writev() (or sendmsg() on a socket) once they run out, so a large
+// store costs one syscall per Chunks * ChunkSize bytes.
+//
+//   FdConfigSink<> sink(fd);
+//   ssize_t written = stream_config(store, sink);
+
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "parameter_registry.h"
+#include "parameter_store.h"
+
+// Renders into [out, out + n) in place; the text is not NUL-terminated.
+class BufferConfigSink
+{
+public:
+    BufferConfigSink(char* out, size_t n) : out_(out), n_(n) {}
+
+    char* chunk(size_t& n)
+    {
+        n = n_ - used_;
+        return out_ + used_;
+    }
+
+    bool emit(size_t used)
+    {
+        used_ += used;
+        return true;
+    }
+
+    bool flush() { return true; }
+
+    size_t size() const { return used_; }
+
+private:
+    char* out_;
+    size_t n_;
+    size_t used_ = 0;
+};
+
+template <size_t ChunkSize = 16 * 1024, size_t Chunks = 4>
+class FdConfigSink
+{
+public:
+    static_assert(ChunkSize > 0 && Chunks > 0, "FdConfigSink needs at least one non-empty chunk");
+
+    // With socket set, writes go through sendmsg(MSG_NOSIGNAL) so a closed
+    // peer fails the write instead of raising SIGPIPE.
+    explicit FdConfigSink(int fd, bool socket = false) : fd_(fd), socket_(socket) {}
+
+    FdConfigSink(const FdConfigSink&) = delete;
+    FdConfigSink& operator=(const FdConfigSink&) = delete;
+
+    char* chunk(size_t& n)
+    {
+        if (filled_ == Chunks && !flush()) return nullptr;
+        n = ChunkSize;
+        return chunks_[filled_];
+    }
+
+    bool emit(size_t used)
+    {
+        if (used == 0) return true;
+        iov_[filled_].iov_base = chunks_[filled_];
+        iov_[filled_].iov_len = used;
+        ++filled_;
+        return true;
+    }
+
+    bool flush()
+    {
+        iovec* iov = iov_;
+        size_t count = filled_;
+        while (count)
+        {
+            const ssize_t w = write_vector(iov, count);
+            if (w < 0)
+            {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            written_ += static_cast<uint64_t>(w);
+            // Skip what went out; a short write leaves the rest of one chunk.
+            for (size_t left = static_cast<size_t>(w); left;)
+            {
+                if (left < iov->iov_len)
+                {
+                    iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                    iov->iov_len -= left;
+                    break;
+                }
+                left -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+        }
+        filled_ = 0;
+        return true;
+    }
+
+    // Bytes the kernel has accepted so far.
+    uint64_t written() const { return written_; }
+
+private:
+    ssize_t write_vector(const iovec* iov, size_t count)
+    {
+        if (!socket_) return ::writev(fd_, iov, static_cast<int>(count));
+        msghdr msg {};
+        msg.msg_iov = const_cast<iovec*>(iov);
+        msg.msg_iovlen = count;
+        return ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+    }
+
+    alignas(kCacheLineSize) char chunks_[Chunks][ChunkSize];
+    iovec iov_[Chunks];
+    size_t filled_ = 0;
+    uint64_t written_ = 0;
+    int fd_;
+    bool socket_;
+};
+
+// Streams every parameter, or only the dirty ones, as name=value lines into
+// sink and flushes it. Returns the bytes rendered, or -1 if the sink fails or
+// one line does not fit in an empty chunk.
+template <typename Store, typename Sink>
+ssize_t stream_config(const Store& store, Sink& sink, bool dirty_only = false)
+{
+    using Registry = typename Store::Registry;
+
+    size_t room = 0;
+    char* out = sink.chunk(room);
+    size_t at = 0;
+    size_t total = 0;
+    bool ok = out != nullptr;
+
+    // Renders one line at out + at; returns its length, 0 if it did not fit.
+    auto render = [&](const ParameterOps& ops) -> size_t
+    {
+        const size_t left = room - at;
+        const bool sized = left >= ops.name.size() + ops.max_serialized_size + 1;
+        if (!sized && left < ops.name.size() + 2) return 0;
+        char* p = out + at;
+        std::memcpy(p, ops.name.data(), ops.name.size());
+        p[ops.name.size()] = '=';
+        const size_t value_at = ops.name.size() + 1;
+        const int len = ops.serialize(store.get(ops.id), p + value_at, left - value_at);
+        if (len < 0) return 0;
+        // The newline takes the place of serialize()'s NUL.
+        p[value_at + static_cast<size_t>(len)] = '\n';
+        return value_at + static_cast<size_t>(len) + 1;
+    };
+
+    auto write_line = [&](ParameterID id)
+    {
+        if (!ok) return;
+        const ParameterOps& ops = Registry::table[static_cast<size_t>(id)];
+        size_t len = render(ops);
+        if (len == 0 && at != 0)
+        {
+            // Chunk boundary: hand this one over and retry in the next.
+            ok = sink.emit(at) && (out = sink.chunk(room)) != nullptr;
+            total += at;
+            at = 0;
+            if (ok) len = render(ops);
+        }
+        ok = ok && len != 0;
+        at += len;
+    };
+
+    if (dirty_only)
+    {
+        store.for_each_dirty(write_line);
+    }
+    else
+    {
+        for (size_t i = 0; i < Registry::size; ++i) write_line(static_cast<ParameterID>(i));
+    }
+    if (!ok || !sink.emit(at) || !sink.flush()) return -1;
+    return static_cast<ssize_t>(total + at);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320), table-driven.
+//
+// Used to checksum MappedParameterStore slots and ParameterJournal records.
+// Pass a previous result as crc to continue over non-contiguous pieces.
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace detail
+{
+
+inline constexpr std::array<uint32_t, 256> kCrc32Table = []
+{
+    std::array<uint32_t, 256> t {};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        t[i] = c;
+    }
+    return t;
+}();
+
+inline uint32_t crc32(const unsigned char* p, size_t n, uint32_t crc = 0)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < n; ++i) crc = kCrc32Table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+} // namespace detail
@@ -0,0 +1,481 @@
+#pragma once
+
+// Locale-free, allocation-free float -> text conversion.
+//
+// Two entry points, both writing into [first, last) in the std::to_chars style
+// (no NUL terminator, result.ptr is one past the last character written):
+//
+//   format_float(first, last, v)              shortest text that parses back to
+//                                             exactly v (Ryu), laid out like
+//                                             std::to_chars(first, last, v)
+//   format_float_fixed<P>(first, last, v)     byte-identical to printf("%.<P>f", v)
+//                                             in the default rounding mode
+//
+// max_fixed_length<P>(lo, hi) is the constexpr worst case of the latter over a
+// range, for sizing buffers at compile time.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+enum class FloatFormatError : uint8_t
+{
+    None,
+    BufferTooSmall
+};
+
+struct FloatFormatResult
+{
+    char* ptr;
+    FloatFormatError ec;
+};
+
+namespace detail
+{
+
+inline constexpr char kDigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+inline uint32_t decimal_length(uint32_t v)
+{
+    uint32_t n = 1;
+    for (; v >= 10; v /= 10) ++n;
+    return n;
+}
+
+// Writes the `len` decimal digits of v ending at out + len.
+inline void write_digits(char* out, uint32_t v, uint32_t len)
+{
+    char* p = out + len;
+    while (v >= 100)
+    {
+        const uint32_t r = (v % 100) * 2;
+        v /= 100;
+        *--p = kDigitPairs[r + 1];
+        *--p = kDigitPairs[r];
+    }
+    if (v >= 10)
+    {
+        *--p = kDigitPairs[v * 2 + 1];
+        *--p = kDigitPairs[v * 2];
+    }
+    else if (p != out)
+    {
+        *--p = static_cast<char>('0' + v);
+    }
+    while (p != out) *--p = '0';
+}
+
+inline FloatFormatResult write_text(char* first, char* last, const char* text, size_t len)
+{
+    if (static_cast<size_t>(last - first) < len) return { last, FloatFormatError::BufferTooSmall };
+    std::memcpy(first, text, len);
+    return { first + len, FloatFormatError::None };
+}
+
+// inf / nan spelled the way printf and std::to_chars spell them.
+inline FloatFormatResult write_non_finite(char* first, char* last, bool negative, uint32_t mantissa)
+{
+    if (mantissa) return negative ? write_text(first, last, "-nan", 4) : write_text(first, last, "nan", 3);
+    return negative ? write_text(first, last, "-inf", 4) : write_text(first, last, "inf", 3);
+}
+
+// ---- Ryu (Ulf Adams, PLDI 2018), binary32 variant ----
+
+inline constexpr int kPow5InvBitCount = 59;
+inline constexpr int kPow5BitCount = 61;
+
+inline constexpr uint64_t kPow5InvSplit[31] =
+{
+    0x0800000000000001ULL, 0x0666666666666667ULL, 0x051eb851eb851eb9ULL,
+    0x04189374bc6a7efaULL, 0x068db8bac710cb2aULL, 0x053e2d6238da3c22ULL,
+    0x0431bde82d7b634eULL, 0x06b5fca6af2bd216ULL, 0x055e63b88c230e78ULL,
+    0x044b82fa09b5a52dULL, 0x06df37f675ef6eaeULL, 0x057f5ff85e592558ULL,
+    0x0465e6604b7a8447ULL, 0x0709709a125da071ULL, 0x05a126e1a84ae6c1ULL,
+    0x0480ebe7b9d58567ULL, 0x0734aca5f6226f0bULL, 0x05c3bd5191b525a3ULL,
+    0x049c97747490eae9ULL, 0x0760f253edb4ab0eULL, 0x05e72843249088d8ULL,
+    0x04b8ed0283a6d3e0ULL, 0x078e480405d7b966ULL, 0x060b6cd004ac9452ULL,
+    0x04d5f0a66a23a9dbULL, 0x07bcb43d769f762bULL, 0x063090312bb2c4efULL,
+    0x04f3a68dbc8f03f3ULL, 0x07ec3daf94180651ULL, 0x065697bfa9acd1daULL,
+    0x051212ffbaf0a7e2ULL,};
+
+inline constexpr uint64_t kPow5Split[47] =
+{
+    0x1000000000000000ULL, 0x1400000000000000ULL, 0x1900000000000000ULL,
+    0x1f40000000000000ULL, 0x1388000000000000ULL, 0x186a000000000000ULL,
+    0x1e84800000000000ULL, 0x1312d00000000000ULL, 0x17d7840000000000ULL,
+    0x1dcd650000000000ULL, 0x12a05f2000000000ULL, 0x174876e800000000ULL,
+    0x1d1a94a200000000ULL, 0x12309ce540000000ULL, 0x16bcc41e90000000ULL,
+    0x1c6bf52634000000ULL, 0x11c37937e0800000ULL, 0x16345785d8a00000ULL,
+    0x1bc16d674ec80000ULL, 0x1158e460913d0000ULL, 0x15af1d78b58c4000ULL,
+    0x1b1ae4d6e2ef5000ULL, 0x10f0cf064dd59200ULL, 0x152d02c7e14af680ULL,
+    0x1a784379d99db420ULL, 0x108b2a2c28029094ULL, 0x14adf4b7320334b9ULL,
+    0x19d971e4fe8401e7ULL, 0x1027e72f1f128130ULL, 0x1431e0fae6d7217cULL,
+    0x193e5939a08ce9dbULL, 0x1f8def8808b02452ULL, 0x13b8b5b5056e16b3ULL,
+    0x18a6e32246c99c60ULL, 0x1ed09bead87c0378ULL, 0x13426172c74d822bULL,
+    0x1812f9cf7920e2b6ULL, 0x1e17b84357691b64ULL, 0x12ced32a16a1b11eULL,
+    0x178287f49c4a1d66ULL, 0x1d6329f1c35ca4bfULL, 0x125dfa371a19e6f7ULL,
+    0x16f578c4e0a060b5ULL, 0x1cb2d6f618c878e3ULL, 0x11efc659cf7d4b8dULL,
+    0x166bb7f0435c9e71ULL, 0x1c06a5ec5433c60dULL,};
+
+inline int32_t pow5bits(int32_t e) { return static_cast<int32_t>((static_cast<uint32_t>(e) * 1217359) >> 19) + 1; }
+inline uint32_t log10_pow2(int32_t e) { return (static_cast<uint32_t>(e) * 78913) >> 18; }
+inline uint32_t log10_pow5(int32_t e) { return (static_cast<uint32_t>(e) * 732923) >> 20; }
+
+inline bool multiple_of_pow5(uint32_t v, uint32_t p)
+{
+    uint32_t count = 0;
+    for (; v % 5 == 0 && v != 0; v /= 5) ++count;
+    return count >= p;
+}
+
+inline bool multiple_of_pow2(uint32_t v, uint32_t p) { return (v & ((1u << p) - 1)) == 0; }
+
+inline uint32_t mul_shift32(uint32_t m, uint64_t factor, int32_t shift)
+{
+    const uint64_t bits0 = static_cast<uint64_t>(m) * static_cast<uint32_t>(factor);
+    const uint64_t bits1 = static_cast<uint64_t>(m) * static_cast<uint32_t>(factor >> 32);
+    return static_cast<uint32_t>(((bits0 >> 32) + bits1) >> (shift - 32));
+}
+
+struct DecimalFloat
+{
+    uint32_t mantissa;
+    int32_t exponent;
+};
+
+// Shortest decimal mantissa * 10^exponent that rounds back to the given
+// finite, non-zero binary32.
+inline DecimalFloat shortest_decimal(uint32_t ieee_mantissa, uint32_t ieee_exponent)
+{
+    int32_t e2;
+    uint32_t m2;
+    if (ieee_exponent == 0)
+    {
+        e2 = 1 - 127 - 23 - 2;
+        m2 = ieee_mantissa;
+    }
+    else
+    {
+        e2 = static_cast<int32_t>(ieee_exponent) - 127 - 23 - 2;
+        m2 = (1u << 23) | ieee_mantissa;
+    }
+    const bool accept_bounds = (m2 & 1) == 0;
+
+    // Interval of decimals that round to this float, scaled by 4.
+    const uint32_t mv = 4 * m2;
+    const uint32_t mp = 4 * m2 + 2;
+    const uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+    const uint32_t mm = 4 * m2 - 1 - mm_shift;
+
+    uint32_t vr, vp, vm;
+    int32_t e10;
+    bool vm_trailing_zeros = false;
+    bool vr_trailing_zeros = false;
+    uint8_t last_removed_digit = 0;
+    if (e2 >= 0)
+    {
+        const uint32_t q = log10_pow2(e2);
+        e10 = static_cast<int32_t>(q);
+        const int32_t k = kPow5InvBitCount + pow5bits(static_cast<int32_t>(q)) - 1;
+        const int32_t i = -e2 + static_cast<int32_t>(q) + k;
+        vr = mul_shift32(mv, kPow5InvSplit[q], i);
+        vp = mul_shift32(mp, kPow5InvSplit[q], i);
+        vm = mul_shift32(mm, kPow5InvSplit[q], i);
+        if (q != 0 && (vp - 1) / 10 <= vm / 10)
+        {
+            const int32_t l = kPow5InvBitCount + pow5bits(static_cast<int32_t>(q) - 1) - 1;
+            last_removed_digit = static_cast<uint8_t>(
+                mul_shift32(mv, kPow5InvSplit[q - 1], -e2 + static_cast<int32_t>(q) - 1 + l) % 10);
+        }
+        if (q <= 9)
+        {
+            // At most one of mp, mv and mm is a multiple of 5.
+            if (mv % 5 == 0) vr_trailing_zeros = multiple_of_pow5(mv, q);
+            else if (accept_bounds) vm_trailing_zeros = multiple_of_pow5(mm, q);
+            else vp -= multiple_of_pow5(mp, q);
+        }
+    }
+    else
+    {
+        const uint32_t q = log10_pow5(-e2);
+        e10 = static_cast<int32_t>(q) + e2;
+        const int32_t i = -e2 - static_cast<int32_t>(q);
+        const int32_t k = pow5bits(i) - kPow5BitCount;
+        int32_t j = static_cast<int32_t>(q) - k;
+        vr = mul_shift32(mv, kPow5Split[i], j);
+        vp = mul_shift32(mp, kPow5Split[i], j);
+        vm = mul_shift32(mm, kPow5Split[i], j);
+        if (q != 0 && (vp - 1) / 10 <= vm / 10)
+        {
+            j = static_cast<int32_t>(q) - 1 - (pow5bits(i + 1) - kPow5BitCount);
+            last_removed_digit = static_cast<uint8_t>(mul_shift32(mv, kPow5Split[i + 1], j) % 10);
+        }
+        if (q <= 1)
+        {
+            // mv = 4 * m2 always has at least q trailing zero bits.
+            vr_trailing_zeros = true;
+            if (accept_bounds) vm_trailing_zeros = mm_shift == 1;
+            else --vp;
+        }
+        else if (q < 31)
+        {
+            vr_trailing_zeros = multiple_of_pow2(mv, q - 1);
+        }
+    }
+
+    // Drop digits while the interval still contains a shorter candidate.
+    int32_t removed = 0;
+    uint32_t output;
+    if (vm_trailing_zeros || vr_trailing_zeros)
+    {
+        while (vp / 10 > vm / 10)
+        {
+            vm_trailing_zeros &= vm % 10 == 0;
+            vr_trailing_zeros &= last_removed_digit == 0;
+            last_removed_digit = static_cast<uint8_t>(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+        if (vm_trailing_zeros)
+        {
+            while (vm % 10 == 0)
+            {
+                vr_trailing_zeros &= last_removed_digit == 0;
+                last_removed_digit = static_cast<uint8_t>(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removed;
+            }
+        }
+        // Exactly ...50...0: round half to even.
+        if (vr_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) last_removed_digit = 4;
+        output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed_digit >= 5);
+    }
+    else
+    {
+        while (vp / 10 > vm / 10)
+        {
+            last_removed_digit = static_cast<uint8_t>(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+        output = vr + (vr == vm || last_removed_digit >= 5);
+    }
+    return { output, e10 + removed };
+}
+
+} // namespace detail
+
+// v rounded to Precision fractional digits (round half to even on the exact
+// binary value), byte-identical to printf("%.<Precision>f", v).
+template <int Precision>
+FloatFormatResult format_float_fixed(char* first, char* last, float v)
+{
+    static_assert(Precision >= 0 && Precision <= 9, "format_float_fixed supports 0..9 fractional digits");
+    using namespace detail;
+
+    constexpr uint64_t kScale = []
+    {
+        uint64_t s = 1;
+        for (int i = 0; i < Precision; ++i) s *= 10;
+        return s;
+    }();
+
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    const bool negative = (bits >> 31) != 0;
+    const uint32_t ieee_exponent = (bits >> 23) & 0xFF;
+    const uint32_t ieee_mantissa = bits & ((1u << 23) - 1);
+
+    if (ieee_exponent == 0xFF) return write_non_finite(first, last, negative, ieee_mantissa);
+
+    // v = m * 2^e2
+    const uint32_t m = ieee_exponent == 0 ? ieee_mantissa : (ieee_mantissa | (1u << 23));
+    const int32_t e2 = (ieee_exponent == 0 ? 1 : static_cast<int32_t>(ieee_exponent)) - 127 - 23;
+
+    // Integer part as up to 128 bits in 32-bit limbs (FLT_MAX < 2^128), and
+    // the fractional part rounded to Precision digits.
+    uint32_t limbs[4] = {};
+    uint64_t frac_digits = 0;
+    if (e2 >= 0)
+    {
+        const uint64_t wide = static_cast<uint64_t>(m) << (e2 % 32);
+        const int32_t word = e2 / 32;
+        limbs[word] = static_cast<uint32_t>(wide);
+        if (word + 1 < 4) limbs[word + 1] = static_cast<uint32_t>(wide >> 32);
+    }
+    else
+    {
+        const int32_t s = -e2;
+        uint64_t frac = m;
+        if (s < 32)
+        {
+            limbs[0] = m >> s;
+            frac = m & ((1u << s) - 1);
+        }
+        // frac * 10^Precision < 2^54, so for s >= 64 it is always below one half.
+        if (s < 64)
+        {
+            const uint64_t num = frac * kScale;
+            frac_digits = num >> s;
+            const uint64_t rem = num & ((uint64_t(1) << s) - 1);
+            const uint64_t half = uint64_t(1) << (s - 1);
+            const bool odd = Precision > 0 ? (frac_digits & 1) : (limbs[0] & 1);
+            if (rem > half || (rem == half && odd)) ++frac_digits;
+            if (frac_digits == kScale)
+            {
+                frac_digits = 0;
+                ++limbs[0];   // integer part < 2^24 here, cannot carry further
+            }
+        }
+    }
+
+    // Integer part in base 10^9 chunks, most significant first.
+    uint32_t chunks[5];
+    int chunk_count = 0;
+    do
+    {
+        uint64_t rem = 0;
+        for (int i = 3; i >= 0; --i)
+        {
+            const uint64_t cur = (rem << 32) | limbs[i];
+            limbs[i] = static_cast<uint32_t>(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+        chunks[chunk_count++] = static_cast<uint32_t>(rem);
+    } while (limbs[0] | limbs[1] | limbs[2] | limbs[3]);
+
+    const uint32_t lead_len = decimal_length(chunks[chunk_count - 1]);
+    const size_t needed = static_cast<size_t>(negative) + lead_len + 9 * static_cast<size_t>(chunk_count - 1)
+                        + (Precision > 0 ? 1 + Precision : 0);
+    if (static_cast<size_t>(last - first) < needed) return { last, FloatFormatError::BufferTooSmall };
+
+    char* p = first;
+    if (negative) *p++ = '-';
+    write_digits(p, chunks[chunk_count - 1], lead_len);
+    p += lead_len;
+    for (int i = chunk_count - 2; i >= 0; --i)
+    {
+        write_digits(p, chunks[i], 9);
+        p += 9;
+    }
+    if (Precision > 0)
+    {
+        *p++ = '.';
+        write_digits(p, static_cast<uint32_t>(frac_digits), Precision);
+        p += Precision;
+    }
+    return { p, FloatFormatError::None };
+}
+
+// Longest text format_float_fixed<Precision> writes for any v in [lo, hi],
+// without a terminator. -0.0 passes a lo == 0 range check, so lo <= 0 allows
+// a sign. Rounding can carry into a new integer digit (99.999 -> "100.00");
+// adding a whole last-place unit covers that, at worst one byte long.
+template <int Precision>
+constexpr size_t max_fixed_length(float lo, float hi)
+{
+    double scale = 1.0;
+    for (int i = 0; i < Precision; ++i) scale *= 10.0;
+    const auto length = [scale](double magnitude, bool negative)
+    {
+        const double rounded = magnitude + 1.0 / scale;
+        size_t digits = 1;
+        // FLT_MAX has 39 integer digits; the cap also covers "-inf" / "nan".
+        for (double p = 10.0; digits < 39 && p <= rounded; p *= 10.0) ++digits;
+        return static_cast<size_t>(negative) + digits + (Precision > 0 ? 1 + Precision : 0);
+    };
+    const size_t positive = hi >= 0 ? length(hi, false) : 0;
+    const size_t negative = lo <= 0 ? length(-static_cast<double>(lo), true) : 0;
+    return positive > negative ? positive : negative;
+}
+
+// Shortest round-trip representation of v; fixed or scientific notation,
+// whichever is shorter (fixed on a tie), exactly as std::to_chars(first, last, v).
+inline FloatFormatResult format_float(char* first, char* last, float v)
+{
+    using namespace detail;
+
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    const bool negative = (bits >> 31) != 0;
+    const uint32_t ieee_exponent = (bits >> 23) & 0xFF;
+    const uint32_t ieee_mantissa = bits & ((1u << 23) - 1);
+
+    if (ieee_exponent == 0xFF) return write_non_finite(first, last, negative, ieee_mantissa);
+    if (ieee_exponent == 0 && ieee_mantissa == 0) return negative ? write_text(first, last, "-0", 2) : write_text(first, last, "0", 1);
+
+    const DecimalFloat d = shortest_decimal(ieee_mantissa, ieee_exponent);
+    const int32_t olength = static_cast<int32_t>(decimal_length(d.mantissa));
+    const int32_t sci_exponent = d.exponent + olength - 1;
+
+    // Fixed: ddd000 | dd.ddd | 0.000ddd   Scientific: d.ddde+XX (always 2 exponent digits for binary32)
+    const int32_t fixed_len = d.exponent >= 0 ? olength + d.exponent
+                            : (olength + d.exponent > 0 ? olength + 1 : 2 - d.exponent);
+    const int32_t sci_len = olength + (olength > 1 ? 1 : 0) + 4;
+    const bool scientific = sci_len < fixed_len;
+
+    // Like std::to_chars, print integers in fixed notation exactly rather than
+    // as shortest digits padded with zeros (same length, no surprises).
+    if (!scientific && d.exponent > 0) return format_float_fixed<0>(first, last, v);
+
+    const size_t needed = static_cast<size_t>(negative) + static_cast<size_t>(scientific ? sci_len : fixed_len);
+    if (static_cast<size_t>(last - first) < needed) return { last, FloatFormatError::BufferTooSmall };
+
+    char* p = first;
+    if (negative) *p++ = '-';
+
+    if (scientific)
+    {
+        // Leading digit, then the rest after the decimal point.
+        char digits[10];
+        write_digits(digits, d.mantissa, static_cast<uint32_t>(olength));
+        *p++ = digits[0];
+        if (olength > 1)
+        {
+            *p++ = '.';
+            std::memcpy(p, digits + 1, static_cast<size_t>(olength - 1));
+            p += olength - 1;
+        }
+        *p++ = 'e';
+        *p++ = sci_exponent < 0 ? '-' : '+';
+        const uint32_t e = static_cast<uint32_t>(sci_exponent < 0 ? -sci_exponent : sci_exponent);
+        write_digits(p, e, 2);
+        p += 2;
+    }
+    else if (d.exponent == 0)
+    {
+        write_digits(p, d.mantissa, static_cast<uint32_t>(olength));
+        p += olength;
+    }
+    else if (olength + d.exponent > 0)
+    {
+        const int32_t int_len = olength + d.exponent;
+        char digits[10];
+        write_digits(digits, d.mantissa, static_cast<uint32_t>(olength));
+        std::memcpy(p, digits, static_cast<size_t>(int_len));
+        p += int_len;
+        *p++ = '.';
+        std::memcpy(p, digits + int_len, static_cast<size_t>(-d.exponent));
+        p += -d.exponent;
+    }
+    else
+    {
+        const int32_t zeros = -(olength + d.exponent);
+        *p++ = '0';
+        *p++ = '.';
+        std::memset(p, '0', static_cast<size_t>(zeros));
+        p += zeros;
+        write_digits(p, d.mantissa, static_cast<uint32_t>(olength));
+        p += olength;
+    }
+    return { p, FloatFormatError::None };
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+// Generated ParameterTraits members for parameters that wrap one float.
+//
+// A trait derives from FloatParameterTraits, naming itself and the member,
+// and declares only what differs between parameters:
+//
+//   template <>
+//   struct ParameterTraits<TemperatureSetpoint>
+//       : FloatParameterTraits<ParameterTraits<TemperatureSetpoint>, &TemperatureSetpoint::value>
+//   {
+//       static constexpr ParameterID id = ParameterID::TemperatureSetpoint;
+//       static constexpr std::string_view name = "TemperatureSetpoint";
+//       static constexpr float min_v = 0.0f;
+//       static constexpr float max_v = 100.0f;
+//       static constexpr TemperatureSetpoint default_v { 37.5f };
+//   };
+//
+// validate, validate_batch, parse, serialize, max_serialized_size and the
+// binary codec are generated from that; parse, validate and serialize carry
+// StatsProbes (parameter_stats.h), which compile away unless stats are enabled.
+// The member and the bounds are template constants, so validate compiles to
+// a load and two compares against immediates. (C++17 has no float template
+// parameters, hence bounds as members of the derived trait.)
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+#include "float_format.h"
+#include "float_parse.h"
+#include "little_endian.h"
+#include "parameter_error.h"
+#include "parameter_stats.h"
+#include "simd_range.h"
+
+namespace detail
+{
+
+template <typename MemberPtr>
+struct member_pointer;
+
+template <typename C, typename M>
+struct member_pointer<M C::*>
+{
+    using Class = C;
+    using Member = M;
+};
+
+} // namespace detail
+
+template <typename Traits, auto Member, int Precision = 2>
+struct FloatParameterTraits
+{
+    using Type = typename detail::member_pointer<decltype(Member)>::Class;
+    using UnderlyingType = float;
+
+    static_assert(std::is_same_v<typename detail::member_pointer<decltype(Member)>::Member, float>,
+                  "FloatParameterTraits needs a pointer to a float member");
+
+    static constexpr uint16_t schema_version = 1;
+    static constexpr size_t binary_size = sizeof(UnderlyingType);
+
+    // Longest serialize() output over [min_v, max_v], NUL included.
+    static constexpr size_t max_serialized_size = max_fixed_length<Precision>(Traits::min_v, Traits::max_v) + 1;
+
+    // An array of Type is then an array of float the SIMD range kernels scan.
+    static constexpr bool packed = sizeof(Type) == sizeof(float) && std::is_standard_layout_v<Type>;
+
+    static constexpr bool in_range(float v)
+    {
+        static_assert(Traits::min_v <= Traits::max_v, "empty validation range");
+        return v >= Traits::min_v && v <= Traits::max_v;
+    }
+
+    // in_range with the reason and the violated bound.
+    static constexpr ParameterResult check(float v)
+    {
+        if (in_range(v)) return {};
+        if (v != v) return { ParameterError::NotANumber };
+        if (v < Traits::min_v) return { ParameterError::BelowMinimum, 0, Traits::min_v };
+        return { ParameterError::AboveMaximum, 0, Traits::max_v };
+    }
+
+    static ParameterResult validate(const Type& x)
+    {
+        StatsProbe probe(probed_id(), ParameterOp::Validate);
+        const ParameterResult r = check(x.*Member);
+        probe.result(r.ok());
+        return r;
+    }
+
+    // Index of the first element of xs[0, n) that fails validate, or n.
+    static size_t validate_batch(const Type* xs, size_t n)
+    {
+        if constexpr (packed)
+        {
+            return find_out_of_range(reinterpret_cast<const float*>(xs), n, Traits::min_v, Traits::max_v);
+        }
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (!in_range(xs[i].*Member)) return i;
+            }
+            return n;
+        }
+    }
+
+    // Sets bit i % 64 of invalid[i / 64] for each element that fails validate;
+    // invalid must hold (n + 63) / 64 words. Returns the number that fail.
+    static size_t validate_batch(const Type* xs, size_t n, uint64_t* invalid)
+    {
+        if constexpr (packed)
+        {
+            return out_of_range_mask(reinterpret_cast<const float*>(xs), n, Traits::min_v, Traits::max_v, invalid);
+        }
+        else
+        {
+            size_t failed = 0;
+            for (size_t w = 0; w < (n + 63) / 64; ++w) invalid[w] = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (in_range(xs[i].*Member)) continue;
+                invalid[i / 64] |= uint64_t { 1 } << (i % 64);
+                ++failed;
+            }
+            return failed;
+        }
+    }
+
+    // Parses all of `in`; trailing characters are an error. out is only
+    // written when the text is a number, even one that then fails check().
+    static ParameterResult parse(std::string_view in, Type& out)
+    {
+        StatsProbe probe(probed_id(), ParameterOp::Parse);
+        float v{};
+        const FloatParseResult r = parse_float(in, v);
+        const uint32_t stop = static_cast<uint32_t>(r.ptr - in.data());
+        ParameterResult result;
+        switch (r.ec)
+        {
+        case FloatParseError::Empty: result = { ParameterError::Empty }; break;
+        case FloatParseError::InvalidCharacter: result = { ParameterError::InvalidCharacter, stop }; break;
+        case FloatParseError::OutOfRange: result = { ParameterError::OutOfRange }; break;
+        case FloatParseError::None:
+            if (stop != in.size())
+            {
+                result = { ParameterError::TrailingCharacters, stop };
+                break;
+            }
+            out.*Member = v;
+            result = check(v);
+            break;
+        }
+        probe.result(result.ok());
+        return result;
+    }
+
+    static ParameterResult parse(const char* in, Type& out)
+    {
+        return in ? parse(std::string_view(in), out) : ParameterResult { ParameterError::Empty };
+    }
+
+    // Writes "%.<Precision>f" text plus a NUL terminator; returns the text
+    // length, or -1 if it does not fit in n bytes. n >= max_serialized_size
+    // always fits a value that passes validate.
+    static int serialize(const Type& x, char* out, size_t n)
+    {
+        StatsProbe probe(probed_id(), ParameterOp::Serialize);
+        if (!probe.result(n != 0)) return -1;
+        auto r = format_float_fixed<Precision>(out, out + n - 1, x.*Member);
+        if (!probe.result(r.ec == FloatFormatError::None)) return -1;
+        *r.ptr = '\0';
+        return static_cast<int>(r.ptr - out);
+    }
+
+    static size_t serialize_binary(const Type& x, unsigned char* out, size_t n)
+    {
+        if (n < binary_size) return 0;
+        store_le(x.*Member, out);
+        return binary_size;
+    }
+
+    static bool parse_binary(const unsigned char* in, size_t n, Type& out)
+    {
+        if (n < binary_size) return false;
+        Type v = out;
+        v.*Member = load_le<UnderlyingType>(in);
+        if (!in_range(v.*Member)) return false;
+        out = v;
+        return true;
+    }
+
+private:
+    // Traits::id, checked against the stats table when stats are compiled in.
+    static constexpr ParameterID probed_id()
+    {
+        static_assert(!kParameterStatsEnabled || static_cast<size_t>(Traits::id) < kMaxStatsParameters,
+                      "ParameterID past kMaxStatsParameters would not be counted; raise PARAMETER_TRAITS_STATS_MAX_PARAMETERS");
+        return Traits::id;
+    }
+};
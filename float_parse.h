@@ -0,0 +1,532 @@
+#pragma once
+
+// Locale-free, allocation-free text -> float conversion.
+//
+// parse_float() follows the std::from_chars contract: it reads the longest
+// prefix of the input that forms a number, reports where it stopped and never
+// looks at the C locale or needs a NUL terminator. The result is correctly
+// rounded (round-to-nearest-even), using
+//   1. Clinger's fast path when mantissa and power of ten are exact floats,
+//   2. the Eisel-Lemire algorithm for everything else,
+//   3. an exact big-integer comparison for the rare inputs with more than 19
+//      significant digits that Eisel-Lemire cannot settle on its own.
+//
+// Accepted syntax: [+-]digits[.digits][(e|E)[+-]digits], "inf", "infinity"
+// and "nan" (case-insensitive).
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+enum class FloatParseError : uint8_t
+{
+    None,               // a number was parsed
+    Empty,              // the input was empty
+    InvalidCharacter,   // the input does not start with a number
+    OutOfRange          // the number overflows to infinity or underflows to zero
+};
+
+struct FloatParseResult
+{
+    const char* ptr;        // first character not consumed
+    FloatParseError ec;
+};
+
+namespace detail
+{
+
+// 128-bit approximations of 5^q for q in [kMinPow10, kMaxPow10], most
+// significant bit set: truncated for q >= 0, rounded up for q < 0.
+inline constexpr int kMinPow10 = -65;
+inline constexpr int kMaxPow10 = 38;
+
+inline constexpr uint64_t kPow5_128[] =
+{
+    0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+    0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL,
+    0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+    0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL,
+    0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+    0xcdb02555653131b6ULL, 0x3792f412cb06794dULL,
+    0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+    0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL,
+    0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+    0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL,
+    0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+    0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL,
+    0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+    0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL,
+    0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+    0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL,
+    0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+    0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL,
+    0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+    0x9226712162ab070dULL, 0xcab3961304ca70e8ULL,
+    0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+    0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL,
+    0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+    0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL,
+    0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+    0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL,
+    0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+    0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL,
+    0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+    0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL,
+    0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+    0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL,
+    0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+    0xcfb11ead453994baULL, 0x67de18eda5814af2ULL,
+    0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+    0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL,
+    0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+    0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL,
+    0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+    0xc612062576589ddaULL, 0x95364afe032a819eULL,
+    0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+    0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL,
+    0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+    0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL,
+    0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+    0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL,
+    0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+    0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL,
+    0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+    0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL,
+    0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+    0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL,
+    0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+    0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL,
+    0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+    0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL,
+    0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+    0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL,
+    0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+    0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL,
+    0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+    0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL,
+    0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+    0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL,
+    0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL,
+    0xa000000000000000ULL, 0x0000000000000000ULL,
+    0xc800000000000000ULL, 0x0000000000000000ULL,
+    0xfa00000000000000ULL, 0x0000000000000000ULL,
+    0x9c40000000000000ULL, 0x0000000000000000ULL,
+    0xc350000000000000ULL, 0x0000000000000000ULL,
+    0xf424000000000000ULL, 0x0000000000000000ULL,
+    0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xbebc200000000000ULL, 0x0000000000000000ULL,
+    0xee6b280000000000ULL, 0x0000000000000000ULL,
+    0x9502f90000000000ULL, 0x0000000000000000ULL,
+    0xba43b74000000000ULL, 0x0000000000000000ULL,
+    0xe8d4a51000000000ULL, 0x0000000000000000ULL,
+    0x9184e72a00000000ULL, 0x0000000000000000ULL,
+    0xb5e620f480000000ULL, 0x0000000000000000ULL,
+    0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+    0x8e1bc9bf04000000ULL, 0x0000000000000000ULL,
+    0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+    0xde0b6b3a76400000ULL, 0x0000000000000000ULL,
+    0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+    0xad78ebc5ac620000ULL, 0x0000000000000000ULL,
+    0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+    0x878678326eac9000ULL, 0x0000000000000000ULL,
+    0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+    0xd3c21bcecceda100ULL, 0x0000000000000000ULL,
+    0x84595161401484a0ULL, 0x0000000000000000ULL,
+    0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL,
+    0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+    0x813f3978f8940984ULL, 0x4000000000000000ULL,
+    0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+    0xc9f2c9cd04674edeULL, 0xa400000000000000ULL,
+    0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+    0x9dc5ada82b70b59dULL, 0xf020000000000000ULL,
+    0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+    0xf684df56c3e01bc6ULL, 0xc732000000000000ULL,
+    0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+    0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL,
+    0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+    0x96769950b50d88f4ULL, 0x1314448000000000ULL,
+};
+
+struct U128
+{
+    uint64_t low;
+    uint64_t high;
+};
+
+inline U128 full_multiplication(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;
+    uint128 r = static_cast<uint128>(a) * b;
+    return { static_cast<uint64_t>(r), static_cast<uint64_t>(r >> 64) };
+#else
+    uint64_t a_lo = static_cast<uint32_t>(a), a_hi = a >> 32;
+    uint64_t b_lo = static_cast<uint32_t>(b), b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + static_cast<uint32_t>(hi_lo) + lo_hi;
+    return { (cross << 32) | static_cast<uint32_t>(lo_lo), (hi_lo >> 32) + (cross >> 32) + hi_hi };
+#endif
+}
+
+inline int leading_zeroes(uint64_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while (!(x & (uint64_t(1) << 63))) { x <<= 1; ++n; }
+    return n;
+#endif
+}
+
+// IEEE-754 binary32 as (biased exponent, explicit mantissa bits).
+struct AdjustedMantissa
+{
+    uint64_t mantissa;
+    int32_t power2;
+
+    bool operator==(const AdjustedMantissa& o) const { return mantissa == o.mantissa && power2 == o.power2; }
+    bool operator!=(const AdjustedMantissa& o) const { return !(*this == o); }
+};
+
+inline constexpr int kMantissaBits = 23;
+inline constexpr int kMinimumExponent = -127;
+inline constexpr int kInfinitePower = 0xFF;
+
+// Eisel-Lemire: nearest binary32 to w * 10^q, exact for any w < 10^19.
+inline AdjustedMantissa compute_float(int64_t q, uint64_t w)
+{
+    if (w == 0 || q < kMinPow10) return { 0, 0 };
+    if (q > kMaxPow10) return { 0, kInfinitePower };
+
+    int lz = leading_zeroes(w);
+    w <<= lz;
+
+    const size_t index = 2 * static_cast<size_t>(q - kMinPow10);
+    U128 product = full_multiplication(w, kPow5_128[index]);
+    constexpr uint64_t precision_mask = ~uint64_t(0) >> (kMantissaBits + 3);
+    if ((product.high & precision_mask) == precision_mask)
+    {
+        U128 second = full_multiplication(w, kPow5_128[index + 1]);
+        product.low += second.high;
+        if (second.high > product.low) ++product.high;
+    }
+
+    int upperbit = static_cast<int>(product.high >> 63);
+    int shift = upperbit + 64 - kMantissaBits - 3;
+    AdjustedMantissa am;
+    am.mantissa = product.high >> shift;
+    // floor(log2(10^q)) + 63 via ((152170 + 65536) * q) >> 16
+    int32_t power = static_cast<int32_t>(((152170 + 65536) * q) >> 16) + 63;
+    am.power2 = power + upperbit - lz - kMinimumExponent;
+
+    if (am.power2 <= 0)
+    {
+        // subnormal
+        if (-am.power2 + 1 >= 64) return { 0, 0 };
+        am.mantissa >>= -am.power2 + 1;
+        am.mantissa += (am.mantissa & 1);
+        am.mantissa >>= 1;
+        am.power2 = (am.mantissa < (uint64_t(1) << kMantissaBits)) ? 0 : 1;
+        return am;
+    }
+
+    // Exactly halfway between two floats: round to even instead of up.
+    if (product.low <= 1 && q >= -17 && q <= 10 && (am.mantissa & 3) == 1)
+    {
+        if ((am.mantissa << shift) == product.high) am.mantissa &= ~uint64_t(1);
+    }
+
+    am.mantissa += (am.mantissa & 1);
+    am.mantissa >>= 1;
+    if (am.mantissa >= (uint64_t(2) << kMantissaBits))
+    {
+        am.mantissa = uint64_t(1) << kMantissaBits;
+        ++am.power2;
+    }
+    am.mantissa &= ~(uint64_t(1) << kMantissaBits);
+    if (am.power2 >= kInfinitePower) return { 0, kInfinitePower };
+    return am;
+}
+
+// Fixed-capacity unsigned integer for the exact slow path. 1280 bits covers
+// every comparison a binary32 halfway point can need.
+struct BigInt
+{
+    static constexpr size_t kLimbs = 40;
+    uint32_t limb[kLimbs] {};
+    size_t size = 0;
+
+    void mul_add(uint32_t m, uint32_t a)
+    {
+        uint64_t carry = a;
+        for (size_t i = 0; i < size; ++i)
+        {
+            uint64_t t = static_cast<uint64_t>(limb[i]) * m + carry;
+            limb[i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+        if (carry && size < kLimbs) limb[size++] = static_cast<uint32_t>(carry);
+    }
+
+    void mul_pow5(int n)
+    {
+        for (; n >= 13; n -= 13) mul_add(1220703125u, 0);   // 5^13
+        uint32_t m = 1;
+        for (; n > 0; --n) m *= 5;
+        mul_add(m, 0);
+    }
+
+    void shl(int n)
+    {
+        const size_t words = static_cast<size_t>(n) / 32;
+        const int bits = n % 32;
+        if (size == 0) return;
+        size_t new_size = size + words + 1;
+        if (new_size > kLimbs) new_size = kLimbs;
+        for (size_t i = new_size; i-- > 0;)
+        {
+            uint64_t hi = (i >= words && i - words < size) ? limb[i - words] : 0;
+            uint64_t lo = (bits && i >= words + 1 && i - words - 1 < size) ? limb[i - words - 1] : 0;
+            limb[i] = static_cast<uint32_t>((hi << bits) | (lo >> (32 - bits)));
+        }
+        size = new_size;
+        while (size && limb[size - 1] == 0) --size;
+    }
+
+    int compare(const BigInt& o) const
+    {
+        if (size != o.size) return size < o.size ? -1 : 1;
+        for (size_t i = size; i-- > 0;)
+        {
+            if (limb[i] != o.limb[i]) return limb[i] < o.limb[i] ? -1 : 1;
+        }
+        return 0;
+    }
+};
+
+inline bool is_digit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+// Decides between b and its successor by comparing the exact decimal value in
+// [mant_first, mant_last) * 10^exp_part with the halfway point between them.
+inline AdjustedMantissa digit_comparison(const char* mant_first, const char* mant_last,
+                                         int64_t exp_part, AdjustedMantissa b)
+{
+    // Enough significant digits to represent any binary32 halfway point exactly.
+    constexpr int kMaxDigits = 120;
+
+    BigInt digits;
+    int count = 0;
+    int64_t k = exp_part;
+    bool sticky = false;
+    bool fraction = false;
+    for (const char* p = mant_first; p != mant_last; ++p)
+    {
+        if (*p == '.') { fraction = true; continue; }
+        uint32_t d = static_cast<uint32_t>(*p - '0');
+        if (count == 0 && d == 0)
+        {
+            if (fraction) --k;
+            continue;
+        }
+        if (count < kMaxDigits)
+        {
+            digits.mul_add(10, d);
+            ++count;
+            if (fraction) --k;
+        }
+        else
+        {
+            if (!fraction) ++k;
+            sticky |= d != 0;
+        }
+    }
+
+    // halfway = (2m + 1) * 2^(e - 1)
+    uint64_t m = b.power2 == 0 ? b.mantissa : (b.mantissa | (uint64_t(1) << kMantissaBits));
+    int64_t e = (b.power2 == 0 ? 1 : b.power2) - 127 - kMantissaBits;
+    BigInt halfway;
+    uint64_t odd = 2 * m + 1;
+    halfway.limb[0] = static_cast<uint32_t>(odd);
+    halfway.limb[1] = static_cast<uint32_t>(odd >> 32);
+    halfway.size = halfway.limb[1] ? 2 : 1;
+
+    // digits * 5^k * 2^k  vs  halfway * 2^(e - 1)
+    if (k >= 0) digits.mul_pow5(static_cast<int>(k));
+    else halfway.mul_pow5(static_cast<int>(-k));
+    int64_t diff = k - (e - 1);
+    if (diff > 0) digits.shl(static_cast<int>(diff));
+    else if (diff < 0) halfway.shl(static_cast<int>(-diff));
+
+    int cmp = digits.compare(halfway);
+    bool round_up = cmp > 0 || (cmp == 0 && (sticky || (m & 1)));
+    if (!round_up) return b;
+
+    ++b.mantissa;
+    if (b.mantissa == (uint64_t(1) << kMantissaBits))
+    {
+        // carried into the hidden bit: next binade (or subnormal -> normal)
+        b.mantissa = 0;
+        ++b.power2;
+        if (b.power2 == kInfinitePower) return { 0, kInfinitePower };
+    }
+    return b;
+}
+
+inline bool match_insensitive(const char* p, const char* last, const char* word)
+{
+    for (; *word; ++p, ++word)
+    {
+        if (p == last || (*p | 0x20) != *word) return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+inline FloatParseResult parse_float(std::string_view in, float& value)
+{
+    using namespace detail;
+
+    const char* p = in.data();
+    const char* const last = p + in.size();
+    if (p == last) return { p, FloatParseError::Empty };
+
+    bool negative = false;
+    if (*p == '-' || *p == '+')
+    {
+        negative = *p == '-';
+        ++p;
+    }
+
+    // Mantissa: keep the first 19 significant digits in w, fold the rest into
+    // the decimal exponent and remember whether any of them was non-zero.
+    const char* const mant_first = p;
+    uint64_t w = 0;
+    int significant = 0;
+    int64_t exp10 = 0;
+    bool truncated = false;
+
+    const char* int_first = p;
+    for (; p != last && is_digit(*p); ++p)
+    {
+        uint32_t d = static_cast<uint32_t>(*p - '0');
+        if (significant < 19)
+        {
+            w = w * 10 + d;
+            if (w) ++significant;
+        }
+        else
+        {
+            ++exp10;
+            truncated |= d != 0;
+        }
+    }
+    size_t digit_count = static_cast<size_t>(p - int_first);
+
+    if (p != last && *p == '.')
+    {
+        ++p;
+        const char* frac_first = p;
+        for (; p != last && is_digit(*p); ++p)
+        {
+            uint32_t d = static_cast<uint32_t>(*p - '0');
+            if (significant < 19)
+            {
+                w = w * 10 + d;
+                if (w) ++significant;
+                --exp10;
+            }
+            else
+            {
+                truncated |= d != 0;
+            }
+        }
+        digit_count += static_cast<size_t>(p - frac_first);
+    }
+    const char* const mant_last = p;
+
+    if (digit_count == 0)
+    {
+        // No digits: the only other valid spellings are inf and nan.
+        const char* s = mant_first;
+        if (match_insensitive(s, last, "inf"))
+        {
+            s += 3;
+            if (match_insensitive(s, last, "inity")) s += 5;
+            constexpr float inf = std::numeric_limits<float>::infinity();
+            value = negative ? -inf : inf;
+            return { s, FloatParseError::None };
+        }
+        if (match_insensitive(s, last, "nan"))
+        {
+            constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+            value = negative ? -nan : nan;
+            return { s + 3, FloatParseError::None };
+        }
+        return { in.data(), FloatParseError::InvalidCharacter };
+    }
+
+    int64_t exp_part = 0;
+    if (p != last && (*p == 'e' || *p == 'E'))
+    {
+        const char* e = p + 1;
+        bool exp_negative = false;
+        if (e != last && (*e == '-' || *e == '+'))
+        {
+            exp_negative = *e == '-';
+            ++e;
+        }
+        if (e != last && is_digit(*e))
+        {
+            for (; e != last && is_digit(*e); ++e)
+            {
+                if (exp_part < 0x10000) exp_part = exp_part * 10 + (*e - '0');
+            }
+            if (exp_negative) exp_part = -exp_part;
+            p = e;
+        }
+        // else: a bare 'e' is not part of the number
+    }
+
+    if (w == 0)
+    {
+        value = negative ? -0.0f : 0.0f;
+        return { p, FloatParseError::None };
+    }
+
+    const int64_t q = exp10 + exp_part;
+
+    // Clinger: both operands exact in binary32, so one IEEE operation rounds correctly.
+    if (!truncated && w <= (uint64_t(1) << 24) && q >= -10 && q <= 10)
+    {
+        static constexpr float kPow10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                            1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+        float v = static_cast<float>(w);
+        v = q < 0 ? v / kPow10[-q] : v * kPow10[q];
+        value = negative ? -v : v;
+        return { p, FloatParseError::None };
+    }
+
+    AdjustedMantissa am = compute_float(q, w);
+    if (truncated && am != compute_float(q, w + 1))
+    {
+        am = digit_comparison(mant_first, mant_last, exp_part, am);
+    }
+
+    if (am.power2 == kInfinitePower || (am.power2 == 0 && am.mantissa == 0))
+    {
+        return { p, FloatParseError::OutOfRange };
+    }
+
+    uint32_t bits = static_cast<uint32_t>(am.mantissa) | (static_cast<uint32_t>(am.power2) << kMantissaBits);
+    if (negative) bits |= uint32_t(1) << 31;
+    std::memcpy(&value, &bits, sizeof(value));
+    return { p, FloatParseError::None };
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+// Schema-directed loader for configuration as a flat JSON object.
+//
+//   { "TemperatureSetpoint": 45.5, "HighTemperatureAlarm": "90", "zones": [ ... ] }
+//
+// load_json_config() makes one pass over the document and builds nothing:
+// each key is resolved through the registry's perfect hash as soon as its
+// closing quote is found, and a registered key's value (a number, or a
+// string holding one) goes straight from the buffer to the store's ID-based
+// parse, so through ParameterTraits<T>::parse and validate. Values of keys
+// that are not registered, nested objects and arrays included, are skipped
+// without being parsed: strings with find_any<'"', '\\'> and containers with
+// find_any over the five structural characters, 16 bytes per step.
+//
+// Rejected values are reported like parse_config's (ConfigLineError, with
+// the line computed only when there is an error) and loading goes on. A
+// malformed document reports ConfigError::Syntax and stops; values before it
+// stay applied. Keys containing escapes never match a registered name.
+// Nothing allocates.
+//
+//   ConfigParseResult r = load_json_config(json, store, [](const ConfigLineError& e) { ... });
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+#include "config_parser.h"
+#include "parameter_error.h"
+#include "parameter_registry.h"
+#include "simd_scan.h"
+
+namespace detail
+{
+
+inline bool is_json_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+inline const char* skip_json_space(const char* p, const char* end)
+{
+    while (p < end && is_json_space(*p)) ++p;
+    return p;
+}
+
+// p is just past an opening quote; returns just past the closing one, or
+// nullptr if the string is unterminated.
+inline const char* skip_json_string(const char* p, const char* end)
+{
+    for (;;)
+    {
+        p = find_any<'"', '\\'>(p, end);
+        if (p == end) return nullptr;
+        if (*p == '"') return p + 1;
+        if (end - p < 2) return nullptr;
+        p += 2;
+    }
+}
+
+// p is just past an opening '{' or '['; returns just past the bracket that
+// closes it, or nullptr. Only nesting is checked, not the content.
+inline const char* skip_json_container(const char* p, const char* end)
+{
+    size_t depth = 1;
+    for (;;)
+    {
+        p = find_any<'"', '{', '}', '[', ']'>(p, end);
+        if (p == end) return nullptr;
+        switch (*p++)
+        {
+        case '"':
+            p = skip_json_string(p, end);
+            if (!p) return nullptr;
+            break;
+        case '{':
+        case '[':
+            ++depth;
+            break;
+        default:
+            if (--depth == 0) return p;
+            break;
+        }
+    }
+}
+
+// End of a number or literal starting at p.
+inline const char* skip_json_scalar(const char* p, const char* end)
+{
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && !is_json_space(*p)) ++p;
+    return p;
+}
+
+// Skips any value at p; nullptr if it is malformed or missing.
+inline const char* skip_json_value(const char* p, const char* end)
+{
+    if (p == end) return nullptr;
+    if (*p == '"') return skip_json_string(p + 1, end);
+    if (*p == '{' || *p == '[') return skip_json_container(p + 1, end);
+    const char* q = skip_json_scalar(p, end);
+    return q == p ? nullptr : q;
+}
+
+} // namespace detail
+
+template <typename Store, typename OnError>
+ConfigParseResult load_json_config(std::string_view json, Store& store, OnError&& on_error)
+{
+    using Registry = typename Store::Registry;
+
+    ConfigParseResult result { 0, 0 };
+    const char* const begin = json.data();
+    const char* const end = begin + json.size();
+
+    auto fail = [&](const char* at, ConfigError error, ParameterResult cause = {})
+    {
+        size_t line = 1;
+        for (const char* q = begin; (q = find_char(q, at, '\n')) != at; ++q) ++line;
+        ++result.failed;
+        on_error(ConfigLineError { line, static_cast<size_t>(at - begin), error, cause });
+    };
+
+    const char* p = detail::skip_json_space(begin, end);
+    if (p == end || *p != '{')
+    {
+        fail(p, ConfigError::Syntax);
+        return result;
+    }
+    p = detail::skip_json_space(p + 1, end);
+    if (p < end && *p == '}') p = detail::skip_json_space(p + 1, end);
+    else
+    {
+        for (;;)
+        {
+            // "key"
+            if (p == end || *p != '"')
+            {
+                fail(p, ConfigError::Syntax);
+                return result;
+            }
+            const char* key = p + 1;
+            const char* key_end = find_any<'"', '\\'>(key, end);
+            const bool escaped = key_end < end && *key_end == '\\';
+            p = escaped ? detail::skip_json_string(key_end, end) : (key_end < end ? key_end + 1 : nullptr);
+            if (!p)
+            {
+                fail(key - 1, ConfigError::Syntax);
+                return result;
+            }
+
+            // :
+            p = detail::skip_json_space(p, end);
+            if (p == end || *p != ':')
+            {
+                fail(p, ConfigError::Syntax);
+                return result;
+            }
+            p = detail::skip_json_space(p + 1, end);
+
+            // value
+            const ParameterOps* ops = escaped ? nullptr
+                                              : Registry::find(std::string_view(key, static_cast<size_t>(key_end - key)));
+            const char* value_end = detail::skip_json_value(p, end);
+            if (!value_end)
+            {
+                fail(p, ConfigError::Syntax);
+                return result;
+            }
+            if (ops)
+            {
+                // A quoted value is parsed from its contents.
+                const bool quoted = *p == '"';
+                const bool scalar = quoted || (*p != '{' && *p != '[');
+                const std::string_view value = quoted ? std::string_view(p + 1, static_cast<size_t>(value_end - p - 2))
+                                                      : std::string_view(p, static_cast<size_t>(value_end - p));
+                const ParameterResult parsed = scalar ? store.parse(ops->id, value)
+                                                      : ParameterResult { ParameterError::InvalidCharacter };
+                if (parsed) ++result.applied;
+                else fail(value.data() + parsed.offset, ConfigError::InvalidValue, parsed);
+            }
+            p = detail::skip_json_space(value_end, end);
+
+            // , or }
+            if (p < end && *p == ',')
+            {
+                p = detail::skip_json_space(p + 1, end);
+                continue;
+            }
+            if (p < end && *p == '}')
+            {
+                p = detail::skip_json_space(p + 1, end);
+                break;
+            }
+            fail(p, ConfigError::Syntax);
+            return result;
+        }
+    }
+    if (p != end) fail(p, ConfigError::Syntax);
+    return result;
+}
+
+template <typename Store>
+ConfigParseResult load_json_config(std::string_view json, Store& store)
+{
+    return load_json_config(json, store, [](const ConfigLineError&) {});
+}
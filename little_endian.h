@@ -0,0 +1,37 @@
+#pragma once
+
+// Fixed-width little-endian encoding of arithmetic values, independent of
+// host byte order: the building block of every binary format here
+// (binary_codec.h, the journal, the shared-memory bus).
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+template <typename V>
+void store_le(V v, unsigned char* out)
+{
+    static_assert(std::is_arithmetic_v<V>, "store_le encodes arithmetic values");
+    unsigned char bytes[sizeof(V)];
+    std::memcpy(bytes, &v, sizeof(V));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (size_t i = 0; i < sizeof(V); ++i) out[i] = bytes[sizeof(V) - 1 - i];
+#else
+    std::memcpy(out, bytes, sizeof(V));
+#endif
+}
+
+template <typename V>
+V load_le(const unsigned char* in)
+{
+    static_assert(std::is_arithmetic_v<V>, "load_le decodes arithmetic values");
+    unsigned char bytes[sizeof(V)];
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (size_t i = 0; i < sizeof(V); ++i) bytes[i] = in[sizeof(V) - 1 - i];
+#else
+    std::memcpy(bytes, in, sizeof(V));
+#endif
+    V v;
+    std::memcpy(&v, bytes, sizeof(V));
+    return v;
+}
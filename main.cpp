@@ -1,130 +1,218 @@
-// g++ -std=c++17 -O2 parameters_min.cpp -o demo
+// g++ -std=c++17 -O2 main.cpp -o demo -pthread
 
 #include <cstdint>
 #include <cstddef>
 #include <string_view>
-#include <cstdio>
-#include <cstdlib>
 #include <iostream>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "binary_codec.h"
+#include "concurrent_parameter_store.h"
+#include "config_parser.h"
+#include "config_stream_parser.h"
+#include "config_writer.h"
+#include "json_config.h"
+#include "mapped_parameter_store.h"
+#include "parameter_array.h"
+#include "parameter_journal.h"
+#include "parameter_notifier.h"
+#include "parameter_stats.h"
+#include "parameter_store.h"
+#include "parameters.h"
+#include "shared_parameter_bus.h"
+#include "transactional_parameter_store.h"
 
 // --------------------
-// Parameter identities
-// --------------------
-enum class ParameterID : uint16_t
-{
-    TemperatureSetpoint,
-    HighTemperatureAlarm
-};
-
-// --------------------
-// Parameter types
+// Simple demo main
 // --------------------
-struct TemperatureSetpoint
-{
-    float value;
-};
-
-struct HighTemperatureAlarm
+int main()
 {
-    float threshold;
-};
+    // Every parameter in one static block, starting at its default
+    static ParameterStore<Parameters> store;
+    std::cout << "Store: " << sizeof(store) << " bytes\n";
 
-// --------------------
-// ParameterTraits<T>
-// --------------------
-template <typename T>
-struct ParameterTraits;
+    // Parse from text (like CLI input)
+    TemperatureSetpoint sp = store.get<TemperatureSetpoint>();
+    HighTemperatureAlarm hi = store.get<HighTemperatureAlarm>();
+    ParameterTraits<TemperatureSetpoint>::parse("42.0", sp);
+    ParameterTraits<HighTemperatureAlarm>::parse("85.5", hi);
+    store.set(sp);
+    store.set(hi);
 
-// TemperatureSetpoint
-template <>
-struct ParameterTraits<TemperatureSetpoint>
-{
-    using UnderlyingType = float;
+    // Validate
+    std::cout << ParameterTraits<TemperatureSetpoint>::name
+              << " valid? " << (ParameterTraits<TemperatureSetpoint>::validate(sp) ? "yes" : "no") << "\n";
+    std::cout << ParameterTraits<HighTemperatureAlarm>::name
+              << " valid? " << (ParameterTraits<HighTemperatureAlarm>::validate(hi) ? "yes" : "no") << "\n";
 
-    static constexpr std::string_view name = "TemperatureSetpoint";
-    static constexpr TemperatureSetpoint default_v { 37.5f };
+    // Serialize to text, into a buffer sized for the longest in-range value
+    static_assert(ParameterTraits<TemperatureSetpoint>::max_serialized_size == sizeof("100.00"));
+    char buf[Parameters::max_serialized_size];
+    int n1 = ParameterTraits<TemperatureSetpoint>::serialize(store.get<TemperatureSetpoint>(), buf, sizeof(buf));
+    std::cout << "Setpoint: " << (n1 > 0 ? buf : "(err)") << "\n";
+    int n2 = store.serialize(ParameterID::HighTemperatureAlarm, buf, sizeof(buf));
+    std::cout << "High alarm: " << (n2 > 0 ? buf : "(err)") << "\n";
 
-    static bool validate(const TemperatureSetpoint& x)
+    // Dispatch by ID (like a message off the wire)
+    ParameterID wire_id = ParameterID::HighTemperatureAlarm;
+    ParameterResult parsed = store.parse(wire_id, "90.25");
+    std::cout << Parameters::ops(wire_id)->name << " from wire: " << (parsed ? "ok" : to_string(parsed.error))
+              << ", now " << store.get<HighTemperatureAlarm>().threshold << "\n";
+    parsed = store.parse(wire_id, "190");
+    std::cout << "190 rejected: " << to_string(parsed.error) << " " << parsed.bound << "\n";
+
+    // Look up by name (like a name=value config line)
+    std::string_view line = "TemperatureSetpoint=55.0";
+    size_t eq = line.find('=');
+    const ParameterOps* by_name = Parameters::find(line.substr(0, eq));
+    std::cout << line.substr(0, eq) << " -> ParameterID "
+              << (by_name ? static_cast<int>(by_name->id) : -1) << "\n";
+
+    // Load a whole config text in one pass
+    constexpr std::string_view config_text =
+        "# zone 1\n"
+        "TemperatureSetpoint = 45.5\n"
+        "HighTemperatureAlarm=200\n"
+        "Humidity=40\n";
+    ConfigParseResult loaded = parse_config(config_text, store, [](const ConfigLineError& e)
     {
-        return x.value >= 0.0f && x.value <= 100.0f;
-    }
-
-    static bool parse(const char* in, TemperatureSetpoint& out)
+        std::cout << "config line " << e.line << ": " << to_string(e.error);
+        if (e.error == ConfigError::InvalidValue) std::cout << " (" << to_string(e.cause.error) << ")";
+        std::cout << " at byte " << e.offset << "\n";
+    });
+    std::cout << "Config applied " << loaded.applied << ", failed " << loaded.failed << "\n";
+
+    // The same text arriving off a stream in 7-byte pieces, split mid-token
+    static ConfigStreamParser<Parameters> streamed;
+    size_t streamed_updates = 0;
+    auto apply = [&](ParameterID id, const void* v) { streamed_updates += store.set(id, v) ? 1 : 0; };
+    for (size_t at = 0; at < config_text.size(); at += 7) streamed.feed(config_text.substr(at, 7), apply);
+    streamed.finish(apply);
+    std::cout << "Streamed updates: " << streamed_updates << "\n";
+
+    // JSON from upstream tooling: registered keys only, the rest skipped
+    constexpr std::string_view json_text =
+        R"({ "TemperatureSetpoint": 45.5, "zones": [ { "id": 1 } ], "HighTemperatureAlarm": "90.25" })";
+    ConfigParseResult from_json = load_json_config(json_text, store);
+    std::cout << "JSON applied " << from_json.applied << ", failed " << from_json.failed << "\n";
+
+    // Incremental checkpoint: only what changed since the store was created
+    char changed[Parameters::max_config_size];
+    std::cout << "Dirty parameters: " << store.dirty_count() << "\n";
+    if (write_config(store, changed, sizeof(changed), true) > 0) std::cout << changed;
+
+    // Full export streamed straight to stdout, one writev for the lot
+    static FdConfigSink<> exporter(STDOUT_FILENO);
+    std::cout << std::flush;
+    const ssize_t exported = stream_config(store, exporter);
+    std::cout << "Exported " << exported << " bytes\n";
+
+    // Lock-free reads while another thread publishes
+    static ConcurrentParameterStore<Parameters> live;
+    std::thread config([] { live.set(TemperatureSetpoint{ 50.0f }); });
+    config.join();
+    std::cout << "Live setpoint: " << live.get<TemperatureSetpoint>().value << "\n";
+
+    // Alarm watchers get one callback per tick, however many writes landed
+    static ParameterNotifier<Parameters> notifier;
+    static int alarm_callbacks = 0;
+    notifier.subscribe<HighTemperatureAlarm>([](ParameterID, void*) { ++alarm_callbacks; });
+    notifier.start();
+    for (float t : { 81.0f, 82.0f, 83.0f })
     {
-        if (!in) return false;
-        char* end{};
-        float v = std::strtof(in, &end);
-        if (end == in) return false;
-        out.value = v;
-        return validate(out);
+        if (live.set(HighTemperatureAlarm{ t })) notifier.notify<HighTemperatureAlarm>();
     }
+    notifier.stop();
+    std::cout << "Alarm callbacks: " << alarm_callbacks << ", alarm now "
+              << live.get<HighTemperatureAlarm>().threshold << "\n";
 
-    static int serialize(const TemperatureSetpoint& x, char* out, size_t n)
+    // Multi-parameter transaction with a cross-parameter rule
+    static TransactionalParameterStore<Parameters> shared;
+    shared.add_invariant([](const ParameterStore<Parameters>& s)
     {
-        return std::snprintf(out, n, "%.2f", x.value);
-    }
-};
-
-// HighTemperatureAlarm
-template <>
-struct ParameterTraits<HighTemperatureAlarm>
-{
-    using UnderlyingType = float;
-
-    static constexpr std::string_view name = "HighTemperatureAlarm";
-    static constexpr HighTemperatureAlarm default_v { 80.0f };
-
-    static bool validate(const HighTemperatureAlarm& x)
+        return s.get<TemperatureSetpoint>().value < s.get<HighTemperatureAlarm>().threshold;
+    });
+    auto tx = shared.begin();
+    tx.set(TemperatureSetpoint{ 90.0f });
+    tx.set(HighTemperatureAlarm{ 70.0f });
+    std::cout << "Setpoint above alarm committed? " << (tx.commit() ? "yes" : "no") << "\n";
+    tx.set(HighTemperatureAlarm{ 95.0f });
+    std::cout << "Raised alarm too, committed? " << (tx.commit() ? "yes" : "no") << "\n";
+
+    // Binary replication: one parameter, then the whole store
+    unsigned char wire[kSnapshotSize<Parameters>];
+    size_t wn = encode_binary(store, ParameterID::TemperatureSetpoint, wire, sizeof(wire));
+    std::cout << "Binary TemperatureSetpoint: " << wn << " bytes\n";
+    static ParameterStore<Parameters> replica;
+    size_t sn = encode_snapshot(store, wire, sizeof(wire));
+    std::cout << "Snapshot: " << sn << " bytes, restored? "
+              << (decode_snapshot(replica, wire, sn) ? "yes" : "no") << "\n";
+
+    // Many zones: one column per parameter, validated in bulk
+    static FixedParameterArray<1024, TemperatureSetpoint, HighTemperatureAlarm> zones;
+    zones.resize(1024);
+    zones.set(7, TemperatureSetpoint{ 21.0f });
+    std::cout << "Zones: " << zones.size() << ", all valid? " << (zones.validate() ? "yes" : "no")
+              << ", zone 7 setpoint " << zones.get<TemperatureSetpoint>(7).value << "\n";
+
+    // Persist across restarts: mapped file, crash-safe double-buffered commits
+    MappedParameterStore<Parameters> persisted;
+    if (persisted.open("/tmp/PropertyTraits.params"))
     {
-        return x.threshold >= 0.0f && x.threshold <= 150.0f;
+        std::cout << "Persisted generation " << persisted.generation() << ", setpoint "
+                  << persisted.get<TemperatureSetpoint>().value << "\n";
+        persisted.commit(store);
     }
 
-    static bool parse(const char* in, HighTemperatureAlarm& out)
+    // Audit trail: batched journal records, one sync per commit
+    static ParameterJournal<Parameters> journal;
+    if (journal.open("/tmp/PropertyTraits"))
     {
-        if (!in) return false;
-        char* end{};
-        float v = std::strtof(in, &end);
-        if (end == in) return false;
-        out.threshold = v;
-        return validate(out);
+        journal.append_dirty(store);
+        if (journal.commit()) store.clear_dirty();
+        std::cout << "Journal records: " << journal.records() << "\n";
+        journal.compact();
     }
 
-    static int serialize(const HighTemperatureAlarm& x, char* out, size_t n)
+    // Other processes read the same values lock-free through shared memory
+    SharedParameterBus<Parameters> bus;
+    if (bus.create("/PropertyTraits.bus"))
     {
-        return std::snprintf(out, n, "%.2f", x.threshold);
+        const uint32_t seen = bus.version(ParameterID::TemperatureSetpoint);
+        std::cout << std::flush;
+        const pid_t reader = fork();
+        if (reader == 0)
+        {
+            SharedParameterBus<Parameters> view;
+            uint32_t version = seen;
+            if (view.attach("/PropertyTraits.bus"))
+            {
+                while (!view.changed(ParameterID::TemperatureSetpoint, version)) std::this_thread::yield();
+                std::cout << "Reader process: setpoint " << view.get<TemperatureSetpoint>().value
+                          << ", version " << version << std::endl;
+            }
+            _exit(0);
+        }
+        bus.set(TemperatureSetpoint{ 44.0f });
+        if (reader > 0) waitpid(reader, nullptr, 0);
+        SharedParameterBus<Parameters>::unlink("/PropertyTraits.bus");
     }
-};
-
-// --------------------
-// Simple demo main
-// --------------------
-int main()
-{
-    // Defaults
-    TemperatureSetpoint sp = ParameterTraits<TemperatureSetpoint>::default_v;
-    HighTemperatureAlarm hi = ParameterTraits<HighTemperatureAlarm>::default_v;
-
-    // Parse from text (like CLI input)
-    ParameterTraits<TemperatureSetpoint>::parse("42.0", sp);
-    ParameterTraits<HighTemperatureAlarm>::parse("85.5", hi);
-
-    // Validate
-    std::cout << ParameterTraits<TemperatureSetpoint>::name
-              << " valid? " << (ParameterTraits<TemperatureSetpoint>::validate(sp) ? "yes" : "no") << "\n";
-    std::cout << ParameterTraits<HighTemperatureAlarm>::name
-              << " valid? " << (ParameterTraits<HighTemperatureAlarm>::validate(hi) ? "yes" : "no") << "\n";
-
-    // Serialize to text
-    char buf[32];
-    int n1 = ParameterTraits<TemperatureSetpoint>::serialize(sp, buf, sizeof(buf));
-    std::cout << "Setpoint: " << (n1 > 0 ? buf : "(err)") << "\n";
-    int n2 = ParameterTraits<HighTemperatureAlarm>::serialize(hi, buf, sizeof(buf));
-    std::cout << "High alarm: " << (n2 > 0 ? buf : "(err)") << "\n";
 
     // Show validation failure
     TemperatureSetpoint bad{ -10.0f };
     std::cout << "Bad setpoint valid? "
               << (ParameterTraits<TemperatureSetpoint>::validate(bad) ? "yes" : "no") << "\n";
 
+    // Hot-path counters (all zero unless built with PARAMETER_TRAITS_STATS=1)
+    if (kParameterStatsEnabled)
+    {
+        ParameterOpStats parses = parameter_stats(ParameterID::TemperatureSetpoint, ParameterOp::Parse);
+        std::cout << "TemperatureSetpoint parses: " << parses.calls << ", rejected " << parses.failures
+                  << ", " << (parses.calls ? parses.cycles / parses.calls : 0) << " cycles/call\n";
+    }
+
     return 0;
 }
@@ -0,0 +1,211 @@
+#pragma once
+
+// File-backed ParameterStore with crash-safe commits (POSIX mmap).
+//
+// The file holds two slots, each a 64-byte header followed by the exact
+// ParameterStore block image, padded to a page:
+//
+//   magic | layout fingerprint | generation | block size | CRC-32 | block
+//
+// open() maps the file and exposes the newest slot whose header matches, whose
+// checksum verifies and whose every value passes ParameterTraits<T>::validate
+// - in place, with no copy or parse: get() reads a value straight out of the
+// mapped block at its ParameterStore offset, snapshot() copies the block.
+// commit() writes the other slot, stamps it with the next generation and
+// checksum, msyncs it and only then makes it current, so a crash at any point
+// leaves at least one intact slot behind.
+//
+// Not thread-safe; publish through ConcurrentParameterStore or
+// TransactionalParameterStore if other threads read concurrently.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "binary_codec.h"
+#include "crc32.h"
+#include "parameter_registry.h"
+#include "parameter_store.h"
+
+namespace detail
+{
+
+struct alignas(kCacheLineSize) MappedSlotHeader
+{
+    uint32_t magic;
+    uint32_t fingerprint;
+    uint64_t generation;
+    uint32_t block_size;
+    uint32_t checksum;      // CRC-32 over generation and block
+};
+
+} // namespace detail
+
+template <typename Registry>
+class MappedParameterStore
+{
+public:
+    using Store = ParameterStore<Registry>;
+
+    MappedParameterStore() = default;
+    MappedParameterStore(const MappedParameterStore&) = delete;
+    MappedParameterStore& operator=(const MappedParameterStore&) = delete;
+
+    ~MappedParameterStore()
+    {
+        close();
+    }
+
+    // Maps path, creating it (with every parameter at its default) if it is
+    // missing or holds no usable slot. Returns false on I/O errors (errno set).
+    bool open(const char* path)
+    {
+        close();
+        fd_ = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) return false;
+
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0 || (static_cast<size_t>(st.st_size) < kFileSize && ::ftruncate(fd_, kFileSize) != 0))
+        {
+            close();
+            return false;
+        }
+
+        void* map = ::mmap(nullptr, kFileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED)
+        {
+            close();
+            return false;
+        }
+        base_ = static_cast<unsigned char*>(map);
+
+        const bool a = slot_is_valid(0);
+        const bool b = slot_is_valid(1);
+        if (a || b)
+        {
+            active_ = (a && b) ? (header(1).generation > header(0).generation ? 1 : 0) : (b ? 1 : 0);
+            return true;
+        }
+
+        // Fresh or unusable file: start from defaults.
+        Store defaults;
+        active_ = 1;
+        header(1).generation = 0;
+        return commit(defaults);
+    }
+
+    void close()
+    {
+        if (base_) ::munmap(base_, kFileSize);
+        if (fd_ >= 0) ::close(fd_);
+        base_ = nullptr;
+        fd_ = -1;
+    }
+
+    bool is_open() const { return base_ != nullptr; }
+
+    // Current committed value, read straight from the mapping.
+    template <typename T>
+    const T& get() const
+    {
+        return *std::launder(reinterpret_cast<const T*>(block(active_) + Store::template offset_of<T>()));
+    }
+
+    // ID-based access to the committed values; nullptr for unknown IDs.
+    const void* get(ParameterID id) const
+    {
+        return Registry::contains_id(id) ? block(active_) + Store::offsets[static_cast<size_t>(id)] : nullptr;
+    }
+
+    // The committed value block, laid out as Store::data().
+    const unsigned char* data() const
+    {
+        return block(active_);
+    }
+
+    // Copies every committed value into out, leaving its dirty bits alone.
+    void snapshot(Store& out) const
+    {
+        std::memcpy(out.data(), block(active_), Store::size_bytes);
+    }
+
+    uint64_t generation() const { return header(active_).generation; }
+
+    // Durably replaces every value with `next` if each one validates.
+    bool commit(const Store& next)
+    {
+        if (!base_ || !values_are_valid(next.data())) return false;
+
+        const int target = 1 - active_;
+        detail::MappedSlotHeader& h = header(target);
+        const uint64_t generation = header(active_).generation + 1;
+
+        // Invalidate first so a torn write can never look valid.
+        h.magic = 0;
+        std::memcpy(block(target), next.data(), Store::size_bytes);
+        h.fingerprint = detail::snapshot_fingerprint<Registry>();
+        h.generation = generation;
+        h.block_size = static_cast<uint32_t>(Store::size_bytes);
+        h.checksum = checksum(target);
+        h.magic = kSnapshotMagic;
+        if (::msync(base_ + target * kSlotSize, kSlotSize, MS_SYNC) != 0) return false;
+
+        active_ = target;
+        return true;
+    }
+
+private:
+    static constexpr size_t kPageSize = 4096;
+    static constexpr size_t kSlotSize =
+        (sizeof(detail::MappedSlotHeader) + Store::size_bytes + kPageSize - 1) / kPageSize * kPageSize;
+    static constexpr size_t kFileSize = 2 * kSlotSize;
+
+    static_assert(sizeof(detail::MappedSlotHeader) % kCacheLineSize == 0, "block must stay cache-line aligned");
+
+    detail::MappedSlotHeader& header(int slot) const
+    {
+        return *reinterpret_cast<detail::MappedSlotHeader*>(base_ + slot * kSlotSize);
+    }
+
+    unsigned char* block(int slot) const
+    {
+        return base_ + slot * kSlotSize + sizeof(detail::MappedSlotHeader);
+    }
+
+    uint32_t checksum(int slot) const
+    {
+        const uint64_t generation = header(slot).generation;
+        unsigned char gen[sizeof(generation)];
+        std::memcpy(gen, &generation, sizeof(generation));
+        return detail::crc32(block(slot), Store::size_bytes, detail::crc32(gen, sizeof(gen)));
+    }
+
+    static bool values_are_valid(const unsigned char* data)
+    {
+        for (size_t i = 0; i < Registry::size; ++i)
+        {
+            if (!Registry::table[i].validate(data + Store::offsets[i])) return false;
+        }
+        return true;
+    }
+
+    bool slot_is_valid(int slot) const
+    {
+        const detail::MappedSlotHeader& h = header(slot);
+        return h.magic == kSnapshotMagic
+            && h.fingerprint == detail::snapshot_fingerprint<Registry>()
+            && h.block_size == Store::size_bytes
+            && h.checksum == checksum(slot)
+            && values_are_valid(block(slot));
+    }
+
+    int fd_ = -1;
+    unsigned char* base_ = nullptr;
+    int active_ = 0;
+};
@@ -0,0 +1,278 @@
+#pragma once
+
+// Structure-of-arrays storage for many instances of the same parameters,
+// e.g. one TemperatureSetpoint / HighTemperatureAlarm pair per zone.
+//
+// Each parameter type gets its own contiguous, cache-line-aligned column, so
+// scanning one field touches only that field's bytes. A parameter must be
+// layout-identical to its ParameterTraits<T>::UnderlyingType (a struct
+// wrapping one value); values<T>() then exposes the column as a plain
+// UnderlyingType array for vectorized consumers, and bulk validation goes
+// through ParameterTraits<T>::validate_batch when the trait has one.
+//
+//   FixedParameterArray<N, Ts...>   columns are std::array<T, N>; no heap
+//   ParameterArray<Ts...>           columns are std::vector<T> with a cache-line
+//                                   aligned allocator; grows
+//
+// Like the stores, values start at default_v and set() validates first;
+// bulk set() is all-or-nothing.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "parameter_registry.h"
+#include "parameter_store.h"
+
+inline constexpr size_t kDynamicCapacity = static_cast<size_t>(-1);
+
+namespace detail
+{
+
+template <typename T, typename = void>
+struct has_validate_batch : std::false_type
+{
+};
+
+template <typename T>
+struct has_validate_batch<T, std::void_t<decltype(ParameterTraits<T>::validate_batch(
+                                 std::declval<const T*>(), size_t {}))>> : std::true_type
+{
+};
+
+// Allocates through aligned operator new, so a growable column starts on a
+// cache line like the fixed one.
+template <typename T>
+struct CacheLineAllocator
+{
+    using value_type = T;
+
+    CacheLineAllocator() = default;
+
+    template <typename U>
+    CacheLineAllocator(const CacheLineAllocator<U>&)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t { kCacheLineSize }));
+    }
+
+    void deallocate(T* p, size_t)
+    {
+        ::operator delete(p, std::align_val_t { kCacheLineSize });
+    }
+
+    template <typename U>
+    bool operator==(const CacheLineAllocator<U>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const CacheLineAllocator<U>&) const { return false; }
+};
+
+template <typename T, size_t Capacity>
+struct ParameterColumn
+{
+    alignas(kCacheLineSize) std::array<T, Capacity> values;
+
+    T* data() { return values.data(); }
+    const T* data() const { return values.data(); }
+    bool resize(size_t n) { return n <= Capacity; }
+};
+
+template <typename T>
+struct ParameterColumn<T, kDynamicCapacity>
+{
+    std::vector<T, CacheLineAllocator<T>> values;
+
+    T* data() { return values.data(); }
+    const T* data() const { return values.data(); }
+
+    bool resize(size_t n)
+    {
+        values.resize(n);
+        return true;
+    }
+};
+
+} // namespace detail
+
+template <size_t Capacity, typename... Ts>
+class BasicParameterArray
+{
+public:
+    static_assert(sizeof...(Ts) > 0, "ParameterArray needs at least one parameter");
+    static_assert(((std::is_trivially_copyable_v<Ts> && std::is_standard_layout_v<Ts>) && ...),
+                  "stored parameters must be trivially copyable, standard-layout structs");
+    static_assert(((sizeof(Ts) == sizeof(typename ParameterTraits<Ts>::UnderlyingType)) && ...),
+                  "each parameter must wrap exactly one UnderlyingType value");
+
+    static constexpr size_t capacity()
+    {
+        return Capacity;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    // Grows or shrinks every column; new elements start at default_v.
+    // Fails (and changes nothing) beyond a fixed capacity.
+    bool resize(size_t n)
+    {
+        if (Capacity != kDynamicCapacity && n > Capacity) return false;
+        (column<Ts>().resize(n), ...);
+        if (n > size_)
+        {
+            (std::fill(column<Ts>().data() + size_, column<Ts>().data() + n, ParameterTraits<Ts>::default_v), ...);
+        }
+        size_ = n;
+        return true;
+    }
+
+    // Restores every element of every column to default_v.
+    void reset()
+    {
+        (std::fill(column<Ts>().data(), column<Ts>().data() + size_, ParameterTraits<Ts>::default_v), ...);
+    }
+
+    template <typename T>
+    const T& get(size_t i) const
+    {
+        return column<T>().data()[i];
+    }
+
+    template <typename T>
+    bool set(size_t i, const T& v)
+    {
+        if (i >= size_ || !ParameterTraits<T>::validate(v)) return false;
+        column<T>().data()[i] = v;
+        return true;
+    }
+
+    // Copies elements [first, first + n) of T's column into out.
+    template <typename T>
+    bool get(size_t first, T* out, size_t n) const
+    {
+        if (first > size_ || n > size_ - first) return false;
+        std::memcpy(out, column<T>().data() + first, n * sizeof(T));
+        return true;
+    }
+
+    // Writes in[0, n) to elements [first, first + n) if every value validates;
+    // otherwise writes nothing.
+    template <typename T>
+    bool set(size_t first, const T* in, size_t n)
+    {
+        if (first > size_ || n > size_ - first) return false;
+        if (find_invalid(in, n) != n) return false;
+        std::memcpy(column<T>().data() + first, in, n * sizeof(T));
+        return true;
+    }
+
+    // T's column as a contiguous UnderlyingType array of size() elements.
+    template <typename T>
+    const typename ParameterTraits<T>::UnderlyingType* values() const
+    {
+        return reinterpret_cast<const typename ParameterTraits<T>::UnderlyingType*>(column<T>().data());
+    }
+
+    // Index of the first element of T's column that fails validate, or size().
+    template <typename T>
+    size_t first_invalid() const
+    {
+        return find_invalid(column<T>().data(), size_);
+    }
+
+    // True if every element of every column validates.
+    bool validate() const
+    {
+        return ((first_invalid<Ts>() == size_) && ...);
+    }
+
+    template <typename T>
+    int serialize(size_t i, char* out, size_t n) const
+    {
+        return i < size_ ? ParameterTraits<T>::serialize(get<T>(i), out, n) : -1;
+    }
+
+    // Writes elements [first, first + count) of T's column as text, one per
+    // line, plus a NUL terminator; returns the text length, or -1 if it does
+    // not fit in n bytes.
+    template <typename T>
+    int serialize(size_t first, size_t count, char* out, size_t n) const
+    {
+        if (first > size_ || count > size_ - first) return -1;
+        size_t at = 0;
+        for (size_t i = first; i < first + count; ++i)
+        {
+            const int len = ParameterTraits<T>::serialize(get<T>(i), out + at, n - at);
+            if (len < 0 || at + static_cast<size_t>(len) + 1 >= n) return -1;
+            at += static_cast<size_t>(len);
+            out[at++] = '\n';
+        }
+        if (at >= n) return -1;
+        out[at] = '\0';
+        return static_cast<int>(at);
+    }
+
+private:
+    template <typename T>
+    static constexpr size_t index_of()
+    {
+        constexpr bool matches[] = { std::is_same_v<T, Ts>... };
+        for (size_t i = 0; i < sizeof...(Ts); ++i)
+        {
+            if (matches[i]) return i;
+        }
+        return sizeof...(Ts);
+    }
+
+    template <typename T>
+    detail::ParameterColumn<T, Capacity>& column()
+    {
+        static_assert(index_of<T>() < sizeof...(Ts), "T is not stored in this ParameterArray");
+        return std::get<index_of<T>()>(columns_);
+    }
+
+    template <typename T>
+    const detail::ParameterColumn<T, Capacity>& column() const
+    {
+        static_assert(index_of<T>() < sizeof...(Ts), "T is not stored in this ParameterArray");
+        return std::get<index_of<T>()>(columns_);
+    }
+
+    template <typename T>
+    static size_t find_invalid(const T* xs, size_t n)
+    {
+        if constexpr (detail::has_validate_batch<T>::value)
+        {
+            return ParameterTraits<T>::validate_batch(xs, n);
+        }
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (!ParameterTraits<T>::validate(xs[i])) return i;
+            }
+            return n;
+        }
+    }
+
+    std::tuple<detail::ParameterColumn<Ts, Capacity>...> columns_ {};
+    size_t size_ = 0;
+};
+
+template <size_t Capacity, typename... Ts>
+using FixedParameterArray = BasicParameterArray<Capacity, Ts...>;
+
+template <typename... Ts>
+using ParameterArray = BasicParameterArray<kDynamicCapacity, Ts...>;
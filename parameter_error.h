@@ -0,0 +1,63 @@
+#pragma once
+
+// Result of ParameterTraits<T>::parse and ::validate.
+//
+// ParameterResult says why a value was rejected, where in the input and
+// against which bound, so callers can report a precise error without
+// re-running any check. It is a 16-byte trivially copyable aggregate, so it
+// comes back in registers (RAX + XMM0 on x86-64 SysV); nothing throws or
+// allocates. It tests true on success:
+//
+//   if (ParameterResult r = ParameterTraits<T>::parse(text, v); !r) report(r.error, r.offset, r.bound);
+
+#include <cstdint>
+#include <cstddef>
+
+enum class ParameterError : uint8_t
+{
+    None,
+    UnknownParameter,       // the ParameterID is not registered
+    Empty,                  // parse: no input
+    InvalidCharacter,       // parse: the input does not start with a value
+    TrailingCharacters,     // parse: a value followed by unconsumed input
+    OutOfRange,             // parse: the value does not fit the underlying type
+    NotANumber,             // validate: NaN never satisfies a bound
+    BelowMinimum,           // validate: less than `bound`
+    AboveMaximum,           // validate: greater than `bound`
+    ReadOnly                // the target was opened for reading only
+};
+
+struct ParameterResult
+{
+    ParameterError error = ParameterError::None;
+    uint32_t offset = 0;    // parse: byte offset in the input where it failed
+    double bound = 0.0;     // BelowMinimum / AboveMaximum: the violated limit
+
+    constexpr bool ok() const
+    {
+        return error == ParameterError::None;
+    }
+
+    constexpr explicit operator bool() const
+    {
+        return ok();
+    }
+};
+
+inline constexpr const char* to_string(ParameterError e)
+{
+    switch (e)
+    {
+    case ParameterError::None: return "none";
+    case ParameterError::UnknownParameter: return "unknown parameter";
+    case ParameterError::Empty: return "empty";
+    case ParameterError::InvalidCharacter: return "invalid character";
+    case ParameterError::TrailingCharacters: return "trailing characters";
+    case ParameterError::OutOfRange: return "out of range";
+    case ParameterError::NotANumber: return "not a number";
+    case ParameterError::BelowMinimum: return "below minimum";
+    case ParameterError::AboveMaximum: return "above maximum";
+    case ParameterError::ReadOnly: return "read only";
+    }
+    return "unknown";
+}
@@ -0,0 +1,390 @@
+#pragma once
+
+// Append-only write-ahead journal of parameter changes (POSIX).
+//
+// <base>.journal holds a file header (magic "PTJ1" + layout fingerprint)
+// followed by fixed-size records:
+//
+//   u16 ParameterID | u16 schema version | u32 CRC-32 | u64 timestamp (ns) | payload
+//
+// where the payload is the trait's serialize_binary encoding and the CRC
+// covers everything else in the record. append() only encodes into a fixed
+// in-memory buffer; commit() writes the buffer and fdatasyncs once, so any
+// number of changes share one sync (group commit). A full buffer is written
+// out without a sync.
+//
+// open() rebuilds the state from <base>.snapshot (if present) and then the
+// journal, stopping at the first torn or corrupt record and truncating it.
+// compact() folds the journal into a fresh snapshot: it snapshots the state
+// under the lock, writes and renames the snapshot file without holding it,
+// then rewrites the journal with only the records appended meanwhile. Each
+// new file is fsynced before its rename and the directory after it, the
+// snapshot's before the journal is replaced. Records hold absolute values, so
+// replaying a record already in the snapshot is harmless and a crash between
+// any two steps loses nothing. compact() may run on a background thread while
+// others append.
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "binary_codec.h"
+#include "crc32.h"
+#include "parameter_registry.h"
+#include "parameter_store.h"
+
+inline constexpr uint32_t kJournalMagic = 0x314A5450;   // "PTJ1" little-endian
+inline constexpr size_t kJournalHeaderSize = 2 * sizeof(uint32_t);
+inline constexpr size_t kJournalRecordHeaderSize = 16;
+
+template <typename Registry, size_t BufferSize = 64 * 1024>
+class ParameterJournal
+{
+public:
+    using Store = ParameterStore<Registry>;
+
+    static constexpr size_t kMaxPathLength = 255;
+
+    ParameterJournal() = default;
+    ParameterJournal(const ParameterJournal&) = delete;
+    ParameterJournal& operator=(const ParameterJournal&) = delete;
+
+    ~ParameterJournal()
+    {
+        close();
+    }
+
+    static uint64_t now_ns()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    // Opens <base>.journal (creating it if needed) and replays snapshot plus
+    // journal into state(). Fails on I/O errors or a journal written for a
+    // different parameter layout.
+    bool open(const char* base)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        close_locked();
+        if (!make_path(journal_path_, base, ".journal") || !make_path(snapshot_path_, base, ".snapshot")) return false;
+
+        state_.reset();
+        load_snapshot();
+
+        fd_ = ::open(journal_path_, O_RDWR | O_CREAT | O_APPEND, 0644);
+        if (fd_ < 0) return false;
+        if (!replay_locked() || !sync_parent_directory(journal_path_))
+        {
+            close_locked();
+            return false;
+        }
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        close_locked();
+    }
+
+    // Records v if it validates; it reaches disk on the next commit().
+    template <typename T>
+    bool append(const T& v, uint64_t timestamp_ns = now_ns())
+    {
+        return append(ParameterTraits<T>::id, &v, timestamp_ns);
+    }
+
+    bool append(ParameterID id, const void* value, uint64_t timestamp_ns)
+    {
+        const ParameterOps* ops = Registry::ops(id);
+        if (!ops || !ops->validate(value)) return false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fd_ < 0) return false;
+        const size_t record_size = kJournalRecordHeaderSize + ops->binary_size;
+        if (BufferSize - used_ < record_size && !write_buffer()) return false;
+
+        unsigned char* r = buffer_ + used_;
+        store_le(static_cast<uint16_t>(id), r);
+        store_le(ops->schema_version, r + 2);
+        store_le(timestamp_ns, r + 8);
+        ops->serialize_binary(value, r + kJournalRecordHeaderSize, ops->binary_size);
+        store_le(record_crc(r, record_size), r + 4);
+        used_ += record_size;
+
+        state_.set(id, value);
+        ++records_;
+        return true;
+    }
+
+    // Records every parameter that is dirty in store (see
+    // ParameterStore::for_each_dirty); returns how many were appended. Clear
+    // the store's dirty bits once commit() has succeeded.
+    size_t append_dirty(const Store& store, uint64_t timestamp_ns = now_ns())
+    {
+        size_t appended = 0;
+        store.for_each_dirty([&](ParameterID id)
+        {
+            appended += append(id, store.get(id), timestamp_ns) ? 1 : 0;
+        });
+        return appended;
+    }
+
+    // Writes every pending record and syncs once.
+    bool commit()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return fd_ >= 0 && write_buffer() && ::fdatasync(fd_) == 0;
+    }
+
+    // Folds the journal into <base>.snapshot and drops the folded records.
+    bool compact()
+    {
+        Store folded;
+        off_t folded_end;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (fd_ < 0 || !write_buffer() || ::fdatasync(fd_) != 0) return false;
+            folded = state_;
+            folded_end = ::lseek(fd_, 0, SEEK_END);
+        }
+
+        if (!write_snapshot(folded)) return false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fd_ < 0 || !write_buffer()) return false;
+        return rewrite_journal_from(folded_end);
+    }
+
+    // Consistent copy of every parameter as journaled so far.
+    void snapshot(Store& out) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out = state_;
+    }
+
+    // Records appended or replayed since open().
+    size_t records() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_;
+    }
+
+private:
+    static bool make_path(char* out, const char* base, const char* suffix)
+    {
+        const size_t b = std::strlen(base), s = std::strlen(suffix);
+        if (b + s > kMaxPathLength) return false;
+        std::memcpy(out, base, b);
+        std::memcpy(out + b, suffix, s + 1);
+        return true;
+    }
+
+    // Makes a create or rename of path durable: fsyncs the directory entry.
+    static bool sync_parent_directory(const char* path)
+    {
+        char dir[kMaxPathLength + 1] = ".";
+        if (const char* slash = std::strrchr(path, '/'))
+        {
+            const size_t n = slash == path ? 1 : static_cast<size_t>(slash - path);
+            std::memcpy(dir, path, n);
+            dir[n] = '\0';
+        }
+        const int fd = ::open(dir, O_RDONLY | O_DIRECTORY);
+        if (fd < 0) return false;
+        const bool ok = ::fsync(fd) == 0;
+        ::close(fd);
+        return ok;
+    }
+
+    static uint32_t record_crc(const unsigned char* r, size_t record_size)
+    {
+        uint32_t crc = detail::crc32(r, 4);
+        return detail::crc32(r + 8, record_size - 8, crc);
+    }
+
+    static bool write_all(int fd, const unsigned char* p, size_t n)
+    {
+        while (n)
+        {
+            const ssize_t w = ::write(fd, p, n);
+            if (w < 0) return false;
+            p += w;
+            n -= static_cast<size_t>(w);
+        }
+        return true;
+    }
+
+    static void encode_file_header(unsigned char* h)
+    {
+        store_le(kJournalMagic, h);
+        store_le(detail::snapshot_fingerprint<Registry>(), h + 4);
+    }
+
+    bool write_buffer()
+    {
+        if (used_ && !write_all(fd_, buffer_, used_)) return false;
+        used_ = 0;
+        return true;
+    }
+
+    void close_locked()
+    {
+        if (fd_ >= 0)
+        {
+            write_buffer();
+            ::fdatasync(fd_);
+            ::close(fd_);
+        }
+        fd_ = -1;
+        used_ = 0;
+    }
+
+    void load_snapshot()
+    {
+        const int fd = ::open(snapshot_path_, O_RDONLY);
+        if (fd < 0) return;
+        unsigned char image[kSnapshotSize<Registry>];
+        if (::read(fd, image, sizeof(image)) == static_cast<ssize_t>(sizeof(image)))
+        {
+            decode_snapshot(state_, image, sizeof(image));
+        }
+        ::close(fd);
+    }
+
+    // Applies every intact record; a torn or corrupt tail is cut off.
+    bool replay_locked()
+    {
+        records_ = 0;
+        unsigned char header[kJournalHeaderSize];
+        const ssize_t got = ::pread(fd_, header, sizeof(header), 0);
+        if (got == 0)
+        {
+            encode_file_header(header);
+            return write_all(fd_, header, sizeof(header)) && ::fdatasync(fd_) == 0;
+        }
+        if (got != static_cast<ssize_t>(sizeof(header))
+            || load_le<uint32_t>(header) != kJournalMagic
+            || load_le<uint32_t>(header + 4) != detail::snapshot_fingerprint<Registry>())
+        {
+            return false;
+        }
+
+        // Stream the file through buffer_ in chunks; records never straddle
+        // a refill because leftovers are moved to the front first.
+        off_t offset = kJournalHeaderSize;
+        off_t good_end = offset;
+        size_t have = 0;
+        bool intact = true;
+        while (intact)
+        {
+            const ssize_t r = ::pread(fd_, buffer_ + have, BufferSize - have, offset + static_cast<off_t>(have));
+            if (r < 0) return false;
+            have += static_cast<size_t>(r);
+
+            size_t at = 0;
+            while (have - at >= kJournalRecordHeaderSize)
+            {
+                const unsigned char* rec = buffer_ + at;
+                const ParameterOps* ops = Registry::ops(static_cast<ParameterID>(load_le<uint16_t>(rec)));
+                if (!ops || load_le<uint16_t>(rec + 2) != ops->schema_version)
+                {
+                    intact = false;
+                    break;
+                }
+                const size_t record_size = kJournalRecordHeaderSize + ops->binary_size;
+                if (have - at < record_size) break;
+                if (load_le<uint32_t>(rec + 4) != record_crc(rec, record_size))
+                {
+                    intact = false;
+                    break;
+                }
+
+                alignas(std::max_align_t) unsigned char value[Store::size_bytes];
+                std::memcpy(value, state_.get(ops->id), ops->size);
+                if (ops->parse_binary(rec + kJournalRecordHeaderSize, ops->binary_size, value)) state_.set(ops->id, value);
+                ++records_;
+                at += record_size;
+                good_end = offset + static_cast<off_t>(at);
+            }
+
+            if (r == 0) break;
+            std::memmove(buffer_, buffer_ + at, have - at);
+            offset += static_cast<off_t>(at);
+            have -= at;
+        }
+
+        const off_t file_end = ::lseek(fd_, 0, SEEK_END);
+        if (good_end != file_end && (::ftruncate(fd_, good_end) != 0 || ::fdatasync(fd_) != 0)) return false;
+        return true;
+    }
+
+    bool write_snapshot(const Store& folded) const
+    {
+        char tmp_path[kMaxPathLength + 5];
+        std::memcpy(tmp_path, snapshot_path_, std::strlen(snapshot_path_));
+        std::memcpy(tmp_path + std::strlen(snapshot_path_), ".tmp", 5);
+
+        unsigned char image[kSnapshotSize<Registry>];
+        const size_t n = encode_snapshot(folded, image, sizeof(image));
+        const int fd = ::open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        const bool ok = write_all(fd, image, n) && ::fsync(fd) == 0;
+        ::close(fd);
+        return ok && std::rename(tmp_path, snapshot_path_) == 0 && sync_parent_directory(snapshot_path_);
+    }
+
+    // Replaces the journal with a header plus the records after `from`.
+    bool rewrite_journal_from(off_t from)
+    {
+        char tmp_path[kMaxPathLength + 5];
+        std::memcpy(tmp_path, journal_path_, std::strlen(journal_path_));
+        std::memcpy(tmp_path + std::strlen(journal_path_), ".tmp", 5);
+
+        const int fd = ::open(tmp_path, O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0644);
+        if (fd < 0) return false;
+
+        unsigned char header[kJournalHeaderSize];
+        encode_file_header(header);
+        bool ok = write_all(fd, header, sizeof(header));
+        for (off_t at = from; ok;)
+        {
+            const ssize_t r = ::pread(fd_, buffer_, BufferSize, at);
+            if (r <= 0)
+            {
+                ok = r == 0;
+                break;
+            }
+            ok = write_all(fd, buffer_, static_cast<size_t>(r));
+            at += r;
+        }
+        ok = ok && ::fsync(fd) == 0 && std::rename(tmp_path, journal_path_) == 0;
+        if (!ok)
+        {
+            ::close(fd);
+            return false;
+        }
+        // The rename is done: keep appending to the new file even if making
+        // it durable fails, since the old one is no longer reachable.
+        ::close(fd_);
+        fd_ = fd;
+        return sync_parent_directory(journal_path_);
+    }
+
+    mutable std::mutex mutex_;
+    int fd_ = -1;
+    char journal_path_[kMaxPathLength + 1] {};
+    char snapshot_path_[kMaxPathLength + 1] {};
+    Store state_;
+    size_t records_ = 0;
+    size_t used_ = 0;
+    unsigned char buffer_[BufferSize];
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+// Change notifications per ParameterID, with no std::function and no heap.
+//
+// Each parameter has a fixed table of MaxSubscribers (function pointer,
+// context) pairs. Writers call notify(id) after publishing a value; that is a
+// single atomic fetch_or on a pending bitmap and never runs a callback.
+// dispatch() is one "tick": it takes the whole bitmap and calls every
+// subscriber of every changed parameter exactly once, so a burst of writes
+// between ticks is coalesced into one callback per subscriber. Callbacks
+// receive the ID and read the current value from whatever store they watch.
+//
+// Call dispatch() from your own loop for synchronous delivery, or start() a
+// dispatcher thread that ticks every `period` (deferred delivery), so a slow
+// subscriber only ever delays other subscribers, never a writer.
+// subscribe() / unsubscribe() share a mutex with dispatch() that writers
+// never touch; dispatch() holds it only to read each subscriber, not while
+// calling it, so callbacks may subscribe and unsubscribe themselves or others.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "parameter_registry.h"
+
+template <typename Registry, size_t MaxSubscribers = 8>
+class ParameterNotifier
+{
+public:
+    using Callback = void (*)(ParameterID id, void* context);
+
+    ParameterNotifier() = default;
+    ParameterNotifier(const ParameterNotifier&) = delete;
+    ParameterNotifier& operator=(const ParameterNotifier&) = delete;
+
+    ~ParameterNotifier()
+    {
+        stop();
+    }
+
+    // Returns a handle for unsubscribe(), or -1 if id is unknown or its table
+    // is full.
+    int subscribe(ParameterID id, Callback fn, void* context = nullptr)
+    {
+        if (!Registry::contains_id(id) || fn == nullptr) return -1;
+        std::lock_guard<std::mutex> lock(table_mutex_);
+        auto& subs = table_[static_cast<size_t>(id)];
+        for (size_t i = 0; i < MaxSubscribers; ++i)
+        {
+            if (subs[i].fn != nullptr) continue;
+            subs[i] = { fn, context };
+            return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    template <typename T>
+    int subscribe(Callback fn, void* context = nullptr)
+    {
+        return subscribe(ParameterTraits<T>::id, fn, context);
+    }
+
+    // Once this returns the callback will not run again and, unless called
+    // from a callback on the dispatching thread, is not running either.
+    void unsubscribe(ParameterID id, int handle)
+    {
+        if (!Registry::contains_id(id) || handle < 0 || static_cast<size_t>(handle) >= MaxSubscribers) return;
+        const size_t slot = static_cast<size_t>(id) * MaxSubscribers + static_cast<size_t>(handle);
+        std::unique_lock<std::mutex> lock(table_mutex_);
+        table_[static_cast<size_t>(id)][handle] = {};
+        if (dispatch_thread_ == std::this_thread::get_id()) return;
+        idle_.wait(lock, [&] { return calling_ != slot; });
+    }
+
+    // Marks id changed; wait-free, safe from any thread.
+    void notify(ParameterID id)
+    {
+        if (!Registry::contains_id(id)) return;
+        const size_t i = static_cast<size_t>(id);
+        pending_[i / 64].fetch_or(uint64_t { 1 } << (i % 64), std::memory_order_release);
+    }
+
+    template <typename T>
+    void notify()
+    {
+        notify(ParameterTraits<T>::id);
+    }
+
+    // Delivers everything marked since the last tick. Returns the number of
+    // callbacks made. Each subscriber is read under the table mutex and
+    // called without it; calling_ tells unsubscribe() which one is running.
+    size_t dispatch()
+    {
+        std::lock_guard<std::mutex> serial(dispatch_mutex_);
+        set_dispatch_thread(std::this_thread::get_id());
+        size_t calls = 0;
+        for (size_t w = 0; w < kPendingWords; ++w)
+        {
+            uint64_t bits = pending_[w].exchange(0, std::memory_order_acquire);
+            while (bits != 0)
+            {
+                const size_t i = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                bits &= bits - 1;
+                for (size_t j = 0; j < MaxSubscribers; ++j)
+                {
+                    Subscriber s;
+                    {
+                        std::lock_guard<std::mutex> lock(table_mutex_);
+                        s = table_[i][j];
+                        if (s.fn == nullptr) continue;
+                        calling_ = i * MaxSubscribers + j;
+                    }
+                    s.fn(static_cast<ParameterID>(i), s.context);
+                    ++calls;
+                    {
+                        std::lock_guard<std::mutex> lock(table_mutex_);
+                        calling_ = kIdle;
+                    }
+                    idle_.notify_all();
+                }
+            }
+        }
+        set_dispatch_thread(std::thread::id {});
+        return calls;
+    }
+
+    // Starts a dispatcher thread that calls dispatch() every period.
+    // Returns false if one is already running.
+    bool start(std::chrono::microseconds period = std::chrono::milliseconds(1))
+    {
+        if (dispatcher_.joinable()) return false;
+        running_.store(true, std::memory_order_relaxed);
+        dispatcher_ = std::thread([this, period]
+        {
+            while (running_.load(std::memory_order_relaxed))
+            {
+                dispatch();
+                std::this_thread::sleep_for(period);
+            }
+            dispatch();
+        });
+        return true;
+    }
+
+    // Stops the dispatcher thread after a final tick.
+    void stop()
+    {
+        if (!dispatcher_.joinable()) return;
+        running_.store(false, std::memory_order_relaxed);
+        dispatcher_.join();
+    }
+
+private:
+    struct Subscriber
+    {
+        Callback fn = nullptr;
+        void* context = nullptr;
+    };
+
+    static constexpr size_t kPendingWords = (Registry::size + 63) / 64;
+    static constexpr size_t kIdle = ~size_t { 0 };
+
+    void set_dispatch_thread(std::thread::id id)
+    {
+        std::lock_guard<std::mutex> lock(table_mutex_);
+        dispatch_thread_ = id;
+    }
+
+    std::array<std::atomic<uint64_t>, kPendingWords> pending_ {};
+    std::array<std::array<Subscriber, MaxSubscribers>, Registry::size> table_ {};
+    std::mutex table_mutex_;
+    std::condition_variable idle_;          // signalled when calling_ goes back to kIdle
+    size_t calling_ = kIdle;                // id * MaxSubscribers + handle of the running callback
+    std::thread::id dispatch_thread_;       // thread inside dispatch(), if any
+    std::mutex dispatch_mutex_;             // one dispatch() at a time
+    std::atomic<bool> running_ { false };
+    std::thread dispatcher_;
+};
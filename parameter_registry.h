@@ -0,0 +1,209 @@
+#pragma once
+
+// Compile-time ParameterID <-> type registry.
+//
+// ParameterRegistry<Ts...> is the list of registered parameter structs. Each
+// ParameterTraits<T> names its ParameterID through a static `id` member; the
+// registry checks that the IDs are exactly 0..N-1 and generates a constexpr
+// jump table of type-erased parse/validate/serialize entries indexed by the
+// enum value, so runtime dispatch on an ID is a bounds check plus one
+// indirect call. Names resolve through a compile-time minimal perfect hash,
+// so find("HighTemperatureAlarm") is one hash plus one string compare.
+// Text buffer bounds (max_serialized_size, max_config_size) are summed from
+// the traits at compile time.
+// Everything lives in static storage; nothing allocates.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "parameter_error.h"
+#include "perfect_hash.h"
+
+enum class ParameterID : uint16_t;
+
+template <typename T>
+struct ParameterTraits;
+
+// Type-erased view of one ParameterTraits<T>; the void pointers refer to a T.
+struct ParameterOps
+{
+    ParameterID id;
+    std::string_view name;
+    size_t size;
+    size_t align;
+    const void* default_value;
+    uint16_t schema_version;
+    size_t binary_size;
+    size_t max_serialized_size;
+    ParameterResult (*parse)(std::string_view in, void* out);
+    ParameterResult (*validate)(const void* x);
+    int (*serialize)(const void* x, char* out, size_t n);
+    size_t (*serialize_binary)(const void* x, unsigned char* out, size_t n);
+    bool (*parse_binary)(const unsigned char* in, size_t n, void* out);
+};
+
+namespace detail
+{
+
+template <typename T>
+ParameterResult parse_erased(std::string_view in, void* out)
+{
+    return ParameterTraits<T>::parse(in, *static_cast<T*>(out));
+}
+
+template <typename T>
+ParameterResult validate_erased(const void* x)
+{
+    return ParameterTraits<T>::validate(*static_cast<const T*>(x));
+}
+
+template <typename T>
+int serialize_erased(const void* x, char* out, size_t n)
+{
+    return ParameterTraits<T>::serialize(*static_cast<const T*>(x), out, n);
+}
+
+template <typename T>
+size_t serialize_binary_erased(const void* x, unsigned char* out, size_t n)
+{
+    return ParameterTraits<T>::serialize_binary(*static_cast<const T*>(x), out, n);
+}
+
+template <typename T>
+bool parse_binary_erased(const unsigned char* in, size_t n, void* out)
+{
+    return ParameterTraits<T>::parse_binary(in, n, *static_cast<T*>(out));
+}
+
+template <typename T>
+constexpr ParameterOps make_ops()
+{
+    using Traits = ParameterTraits<T>;
+    return { Traits::id, Traits::name, sizeof(T), alignof(T), &Traits::default_v,
+             Traits::schema_version, Traits::binary_size, Traits::max_serialized_size,
+             &parse_erased<T>, &validate_erased<T>, &serialize_erased<T>,
+             &serialize_binary_erased<T>, &parse_binary_erased<T> };
+}
+
+template <typename... Ts>
+constexpr size_t index_of_id(ParameterID id)
+{
+    constexpr ParameterID ids[] = { ParameterTraits<Ts>::id... };
+    size_t i = 0;
+    while (i < sizeof...(Ts) && ids[i] != id) ++i;
+    return i;
+}
+
+template <typename... Ts>
+constexpr bool ids_are_dense()
+{
+    constexpr size_t ids[] = { static_cast<size_t>(ParameterTraits<Ts>::id)... };
+    bool seen[sizeof...(Ts)] {};
+    for (size_t id : ids)
+    {
+        if (id >= sizeof...(Ts) || seen[id]) return false;
+        seen[id] = true;
+    }
+    return true;
+}
+
+} // namespace detail
+
+template <typename... Ts>
+struct ParameterRegistry
+{
+    static constexpr size_t size = sizeof...(Ts);
+
+    // Position of T in the registration list.
+    template <typename T>
+    static constexpr size_t index_of()
+    {
+        constexpr bool matches[] = { std::is_same_v<T, Ts>... };
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (matches[i]) return i;
+        }
+        return size;
+    }
+
+    template <typename T>
+    static constexpr bool contains = index_of<T>() < size;
+
+    // Struct registered for Id, e.g. type<ParameterID::HighTemperatureAlarm>.
+    template <ParameterID Id>
+    using type = std::tuple_element_t<detail::index_of_id<Ts...>(Id), std::tuple<Ts...>>;
+
+    static constexpr bool contains_id(ParameterID id)
+    {
+        return static_cast<size_t>(id) < size;
+    }
+
+    // Jump table indexed by ParameterID.
+    static constexpr std::array<ParameterOps, size> table = []
+    {
+        std::array<ParameterOps, size> t {};
+        for (const ParameterOps& ops : { detail::make_ops<Ts>()... })
+        {
+            t[static_cast<size_t>(ops.id)] = ops;
+        }
+        return t;
+    }();
+
+    // Largest ParameterTraits<T>::max_serialized_size: one buffer that fits
+    // serialize() for any registered parameter.
+    static constexpr size_t max_serialized_size = std::max({ ParameterTraits<Ts>::max_serialized_size... });
+
+    // Longest "name=value\n" dump of every parameter, NUL included.
+    static constexpr size_t max_config_size =
+        ((ParameterTraits<Ts>::name.size() + ParameterTraits<Ts>::max_serialized_size + 1) + ... + 1);
+
+    static constexpr const ParameterOps* ops(ParameterID id)
+    {
+        return contains_id(id) ? &table[static_cast<size_t>(id)] : nullptr;
+    }
+
+    // Perfect hash over the names, in table (ParameterID) order.
+    static constexpr PerfectHash<size> name_index = PerfectHash<size>([]
+    {
+        std::array<std::string_view, size> names {};
+        for (size_t i = 0; i < size; ++i) names[i] = table[i].name;
+        return names;
+    }());
+
+    static constexpr const ParameterOps* find(std::string_view name)
+    {
+        const size_t i = name_index.find(name);
+        return i < size ? &table[i] : nullptr;
+    }
+
+    static ParameterResult parse(ParameterID id, std::string_view in, void* out)
+    {
+        return contains_id(id) ? table[static_cast<size_t>(id)].parse(in, out)
+                               : ParameterResult { ParameterError::UnknownParameter };
+    }
+
+    static ParameterResult parse(ParameterID id, const char* in, void* out)
+    {
+        return in ? parse(id, std::string_view(in), out) : ParameterResult { ParameterError::Empty };
+    }
+
+    static ParameterResult validate(ParameterID id, const void* x)
+    {
+        return contains_id(id) ? table[static_cast<size_t>(id)].validate(x)
+                               : ParameterResult { ParameterError::UnknownParameter };
+    }
+
+    static int serialize(ParameterID id, const void* x, char* out, size_t n)
+    {
+        return contains_id(id) ? table[static_cast<size_t>(id)].serialize(x, out, n) : -1;
+    }
+
+    static_assert(size > 0, "ParameterRegistry needs at least one parameter");
+    static_assert(detail::ids_are_dense<Ts...>(), "registered ParameterIDs must be unique and cover 0..N-1");
+    static_assert(name_index.valid(), "registered parameter names must be unique");
+};
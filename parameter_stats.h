@@ -0,0 +1,244 @@
+#pragma once
+
+// Optional per-trait counters for the parse / validate / serialize hot paths.
+//
+// Build with PARAMETER_TRAITS_STATS=1 (CMake: -DPROPERTYTRAITS_ENABLE_STATS=ON)
+// to count, per ParameterID and operation, the calls, the failures and the
+// cumulative time stamp counter cycles spent inside. Each thread claims its
+// own cache-line-aligned slot from a fixed pool on first use and is its only
+// writer, so counting adds no false sharing and needs no locked instructions;
+// parameter_stats() sums the slots when asked. A thread hands its slot back
+// when it exits (its counts stay in it), so the pool bounds live threads, not
+// threads ever started; beyond kMaxStatsThreads - 1 live threads the rest
+// share the last slot, which uses atomic adds.
+//
+// ParameterIDs are counted up to kMaxStatsParameters (override with
+// PARAMETER_TRAITS_STATS_MAX_PARAMETERS); FloatParameterTraits refuses to
+// compile a probe for an ID past it rather than silently not counting it.
+//
+// Without the define StatsProbe is an empty inline type and every probe
+// compiles away.
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include "cache_line.h"
+#include "parameter_registry.h"
+
+#ifndef PARAMETER_TRAITS_STATS
+#define PARAMETER_TRAITS_STATS 0
+#endif
+
+#ifndef PARAMETER_TRAITS_STATS_MAX_PARAMETERS
+#define PARAMETER_TRAITS_STATS_MAX_PARAMETERS 64
+#endif
+
+#if PARAMETER_TRAITS_STATS
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+inline constexpr bool kParameterStatsEnabled = PARAMETER_TRAITS_STATS != 0;
+inline constexpr size_t kMaxStatsParameters = PARAMETER_TRAITS_STATS_MAX_PARAMETERS;
+inline constexpr size_t kMaxStatsThreads = 64;
+
+enum class ParameterOp : uint8_t
+{
+    Parse,
+    Validate,
+    Serialize
+};
+
+inline constexpr size_t kParameterOpCount = 3;
+
+struct ParameterOpStats
+{
+    uint64_t calls = 0;
+    uint64_t failures = 0;
+    uint64_t cycles = 0;
+};
+
+#if PARAMETER_TRAITS_STATS
+
+namespace detail
+{
+
+struct alignas(kCacheLineSize) StatsSlot
+{
+    struct Counters
+    {
+        std::atomic<uint64_t> calls { 0 };
+        std::atomic<uint64_t> failures { 0 };
+        std::atomic<uint64_t> cycles { 0 };
+    };
+
+    Counters ops[kMaxStatsParameters][kParameterOpCount];
+};
+
+inline std::array<StatsSlot, kMaxStatsThreads>& stats_slots()
+{
+    static std::array<StatsSlot, kMaxStatsThreads> slots;
+    return slots;
+}
+
+// owned[i]: slot i belongs to a live thread. The last slot is always shared.
+inline std::array<std::atomic<bool>, kMaxStatsThreads - 1>& stats_slot_owners()
+{
+    static std::array<std::atomic<bool>, kMaxStatsThreads - 1> owned {};
+    return owned;
+}
+
+struct ThreadStats
+{
+    StatsSlot* slot;
+    bool exclusive;   // false for the last slot, which overflow threads share
+    size_t index;
+
+    // Hands the slot to the next thread; release pairs with the claiming
+    // acquire, so the new owner continues from this thread's counts.
+    ~ThreadStats()
+    {
+        if (exclusive) stats_slot_owners()[index].store(false, std::memory_order_release);
+    }
+};
+
+inline const ThreadStats& this_thread_stats()
+{
+    thread_local const ThreadStats stats = []
+    {
+        auto& owned = stats_slot_owners();
+        for (size_t i = 0; i < kMaxStatsThreads - 1; ++i)
+        {
+            bool expected = false;
+            if (!owned[i].load(std::memory_order_relaxed)
+                && owned[i].compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                return ThreadStats { &stats_slots()[i], true, i };
+            }
+        }
+        return ThreadStats { &stats_slots()[kMaxStatsThreads - 1], false, kMaxStatsThreads - 1 };
+    }();
+    return stats;
+}
+
+// A slot's only writer can skip the locked read-modify-write.
+inline void stats_add(std::atomic<uint64_t>& counter, uint64_t v, bool exclusive)
+{
+    if (exclusive)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+    else
+    {
+        counter.fetch_add(v, std::memory_order_relaxed);
+    }
+}
+
+inline uint64_t read_cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+} // namespace detail
+
+// Counts one call on construction and its cycles on destruction; result()
+// records a failure when passed false.
+class StatsProbe
+{
+public:
+    StatsProbe(ParameterID id, ParameterOp op)
+    {
+        const detail::ThreadStats& stats = detail::this_thread_stats();
+        if (static_cast<size_t>(id) < kMaxStatsParameters)
+        {
+            counters_ = &stats.slot->ops[static_cast<size_t>(id)][static_cast<size_t>(op)];
+        }
+        exclusive_ = stats.exclusive;
+        start_ = detail::read_cycles();
+    }
+
+    StatsProbe(const StatsProbe&) = delete;
+    StatsProbe& operator=(const StatsProbe&) = delete;
+
+    ~StatsProbe()
+    {
+        if (!counters_) return;
+        detail::stats_add(counters_->calls, 1, exclusive_);
+        detail::stats_add(counters_->cycles, detail::read_cycles() - start_, exclusive_);
+    }
+
+    bool result(bool ok)
+    {
+        if (!ok && counters_) detail::stats_add(counters_->failures, 1, exclusive_);
+        return ok;
+    }
+
+private:
+    detail::StatsSlot::Counters* counters_ = nullptr;
+    bool exclusive_ = false;
+    uint64_t start_ = 0;
+};
+
+#else
+
+class StatsProbe
+{
+public:
+    constexpr StatsProbe(ParameterID, ParameterOp) {}
+
+    constexpr bool result(bool ok) const
+    {
+        return ok;
+    }
+};
+
+#endif
+
+// Totals over every thread for one parameter and operation; all zero when
+// stats are compiled out.
+inline ParameterOpStats parameter_stats(ParameterID id, ParameterOp op)
+{
+    ParameterOpStats total;
+#if PARAMETER_TRAITS_STATS
+    if (static_cast<size_t>(id) >= kMaxStatsParameters) return total;
+    for (const detail::StatsSlot& slot : detail::stats_slots())
+    {
+        const auto& c = slot.ops[static_cast<size_t>(id)][static_cast<size_t>(op)];
+        total.calls += c.calls.load(std::memory_order_relaxed);
+        total.failures += c.failures.load(std::memory_order_relaxed);
+        total.cycles += c.cycles.load(std::memory_order_relaxed);
+    }
+#else
+    (void)id;
+    (void)op;
+#endif
+    return total;
+}
+
+// Zeroes every counter. Calls racing with this may be partly counted.
+inline void reset_parameter_stats()
+{
+#if PARAMETER_TRAITS_STATS
+    for (detail::StatsSlot& slot : detail::stats_slots())
+    {
+        for (auto& per_id : slot.ops)
+        {
+            for (auto& c : per_id)
+            {
+                c.calls.store(0, std::memory_order_relaxed);
+                c.failures.store(0, std::memory_order_relaxed);
+                c.cycles.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+// Heap-free storage for every parameter of a registry.
+//
+// ParameterStore<ParameterRegistry<Ts...>> lays the registered structs out
+// back to back, in ParameterID order and at their natural alignment, inside
+// one cache-line-aligned byte block whose size is fixed at compile time. The
+// layout (offset_of, size_bytes) is constexpr, so the block can be copied,
+// snapshotted or mapped as a whole. Values start at ParameterTraits<T>::default_v
+// and only change through set(), which runs ParameterTraits<T>::validate first.
+//
+// After the block sits a dirty bitmap, one bit per ParameterID, set whenever
+// set(), parse() or reset() actually changes a value. Incremental exporters
+// (encode_dirty, write_config, ParameterJournal::append_dirty) walk it with
+// ctz, so a checkpoint costs O(changed) rather than O(all); the caller
+// clear_dirty()s once the checkpoint is safe. Writes through data() are not
+// tracked. A new store starts clean.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <type_traits>
+
+#include "cache_line.h"
+#include "parameter_registry.h"
+
+template <typename Registry>
+class ParameterStore;
+
+template <typename... Ts>
+class alignas(kCacheLineSize) ParameterStore<ParameterRegistry<Ts...>>
+{
+public:
+    using Registry = ParameterRegistry<Ts...>;
+
+    static_assert((std::is_trivially_copyable_v<Ts> && ...),
+                  "stored parameters must be trivially copyable");
+
+    // Byte offset of each parameter in the block, indexed by ParameterID.
+    static constexpr std::array<size_t, Registry::size> offsets = []
+    {
+        std::array<size_t, Registry::size> o {};
+        size_t at = 0;
+        for (size_t i = 0; i < Registry::size; ++i)
+        {
+            const size_t align = Registry::table[i].align;
+            at = (at + align - 1) / align * align;
+            o[i] = at;
+            at += Registry::table[i].size;
+        }
+        return o;
+    }();
+
+    // Whole block, rounded up to a multiple of the cache line.
+    static constexpr size_t size_bytes = []
+    {
+        const ParameterOps& last = Registry::table[Registry::size - 1];
+        const size_t end = offsets[Registry::size - 1] + last.size;
+        return (end + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+    }();
+
+    template <typename T>
+    static constexpr size_t offset_of()
+    {
+        static_assert(Registry::template contains<T>, "T is not registered");
+        return offsets[static_cast<size_t>(ParameterTraits<T>::id)];
+    }
+
+    static constexpr size_t dirty_words = (Registry::size + 63) / 64;
+
+    ParameterStore()
+    {
+        (::new (static_cast<void*>(bytes_ + offset_of<Ts>())) Ts(ParameterTraits<Ts>::default_v), ...);
+    }
+
+    // Restores every parameter to ParameterTraits<T>::default_v, marking
+    // dirty only those that were not already at it.
+    void reset()
+    {
+        (write(static_cast<size_t>(ParameterTraits<Ts>::id), &ParameterTraits<Ts>::default_v), ...);
+    }
+
+    template <typename T>
+    const T& get() const
+    {
+        return *std::launder(reinterpret_cast<const T*>(bytes_ + offset_of<T>()));
+    }
+
+    // Stores v if ParameterTraits<T>::validate accepts it.
+    template <typename T>
+    bool set(const T& v)
+    {
+        if (!ParameterTraits<T>::validate(v)) return false;
+        write(static_cast<size_t>(ParameterTraits<T>::id), &v);
+        return true;
+    }
+
+    // ID-based access for values that arrive type-erased; nullptr for unknown IDs.
+    const void* get(ParameterID id) const
+    {
+        return Registry::contains_id(id) ? bytes_ + offsets[static_cast<size_t>(id)] : nullptr;
+    }
+
+    // Copies the struct at `value` in if it validates.
+    bool set(ParameterID id, const void* value)
+    {
+        if (!Registry::validate(id, value)) return false;
+        write(static_cast<size_t>(id), value);
+        return true;
+    }
+
+    // Parses all of `in` into the stored value; the store is unchanged on
+    // failure.
+    ParameterResult parse(ParameterID id, std::string_view in)
+    {
+        if (!Registry::contains_id(id)) return { ParameterError::UnknownParameter };
+        const size_t i = static_cast<size_t>(id);
+        alignas(Ts...) unsigned char scratch[std::max({ sizeof(Ts)... })];
+        std::memcpy(scratch, bytes_ + offsets[i], Registry::table[i].size);
+        const ParameterResult r = Registry::table[i].parse(in, scratch);
+        if (r) write(i, scratch);
+        return r;
+    }
+
+    ParameterResult parse(ParameterID id, const char* in)
+    {
+        return in ? parse(id, std::string_view(in)) : ParameterResult { ParameterError::Empty };
+    }
+
+    int serialize(ParameterID id, char* out, size_t n) const
+    {
+        const void* x = get(id);
+        return x ? Registry::table[static_cast<size_t>(id)].serialize(x, out, n) : -1;
+    }
+
+    // Raw block for snapshot/restore; writing through it bypasses validate
+    // and the dirty bitmap.
+    const unsigned char* data() const { return bytes_; }
+    unsigned char* data() { return bytes_; }
+
+    bool is_dirty(ParameterID id) const
+    {
+        const size_t i = static_cast<size_t>(id);
+        return Registry::contains_id(id) && (dirty_[i / 64] >> (i % 64) & 1);
+    }
+
+    void mark_dirty(ParameterID id)
+    {
+        const size_t i = static_cast<size_t>(id);
+        if (Registry::contains_id(id)) dirty_[i / 64] |= uint64_t { 1 } << (i % 64);
+    }
+
+    void clear_dirty()
+    {
+        for (uint64_t& w : dirty_) w = 0;
+    }
+
+    size_t dirty_count() const
+    {
+        size_t n = 0;
+        for (uint64_t w : dirty_) n += static_cast<size_t>(__builtin_popcountll(w));
+        return n;
+    }
+
+    // Calls f(ParameterID) for each dirty parameter, in ID order.
+    template <typename F>
+    void for_each_dirty(F&& f) const
+    {
+        for (size_t w = 0; w < dirty_words; ++w)
+        {
+            for (uint64_t bits = dirty_[w]; bits != 0; bits &= bits - 1)
+            {
+                f(static_cast<ParameterID>(w * 64 + static_cast<size_t>(__builtin_ctzll(bits))));
+            }
+        }
+    }
+
+private:
+    // Copies a validated value in, marking it dirty if the bytes change.
+    void write(size_t i, const void* value)
+    {
+        unsigned char* at = bytes_ + offsets[i];
+        if (std::memcmp(at, value, Registry::table[i].size) == 0) return;
+        std::memcpy(at, value, Registry::table[i].size);
+        dirty_[i / 64] |= uint64_t { 1 } << (i % 64);
+    }
+
+    unsigned char bytes_[size_bytes] {};
+    uint64_t dirty_[dirty_words] {};
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+// The registered parameters: identities, structs and their ParameterTraits.
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+#include "float_parameter_traits.h"
+#include "parameter_registry.h"
+
+// --------------------
+// Parameter identities
+// --------------------
+enum class ParameterID : uint16_t
+{
+    TemperatureSetpoint,
+    HighTemperatureAlarm
+};
+
+// --------------------
+// Parameter types
+// --------------------
+struct TemperatureSetpoint
+{
+    float value;
+};
+
+struct HighTemperatureAlarm
+{
+    float threshold;
+};
+
+// --------------------
+// ParameterTraits<T>
+// --------------------
+template <typename T>
+struct ParameterTraits;
+
+// TemperatureSetpoint
+template <>
+struct ParameterTraits<TemperatureSetpoint>
+    : FloatParameterTraits<ParameterTraits<TemperatureSetpoint>, &TemperatureSetpoint::value>
+{
+    static constexpr ParameterID id = ParameterID::TemperatureSetpoint;
+    static constexpr std::string_view name = "TemperatureSetpoint";
+    static constexpr float min_v = 0.0f;
+    static constexpr float max_v = 100.0f;
+    static constexpr TemperatureSetpoint default_v { 37.5f };
+};
+
+// HighTemperatureAlarm
+template <>
+struct ParameterTraits<HighTemperatureAlarm>
+    : FloatParameterTraits<ParameterTraits<HighTemperatureAlarm>, &HighTemperatureAlarm::threshold>
+{
+    static constexpr ParameterID id = ParameterID::HighTemperatureAlarm;
+    static constexpr std::string_view name = "HighTemperatureAlarm";
+    static constexpr float min_v = 0.0f;
+    static constexpr float max_v = 150.0f;
+    static constexpr HighTemperatureAlarm default_v { 80.0f };
+};
+
+// --------------------
+// Registry
+// --------------------
+using Parameters = ParameterRegistry<TemperatureSetpoint, HighTemperatureAlarm>;
@@ -0,0 +1,195 @@
+#pragma once
+
+// Compile-time minimal perfect hash over a fixed set of strings.
+//
+// Each key is hashed eight bytes at a time (shorter keys and the tail in one
+// overlapping load) and finished with one 64-bit mix. The mixed hash picks the
+// key's bucket; each bucket gets a seed, chosen at compile time (largest
+// buckets first), that sends all of its keys to still-free slots of an N-slot
+// table ("hash and displace"), the slot being one multiply of the same mixed
+// hash by the seed. Ranges are reduced with a multiply-shift, not a division.
+// A lookup is that hash, two multiplies and a single string compare against
+// the only key that can live in the resulting slot.
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace detail
+{
+
+// Byte-serial FNV-1a; stable across builds, so layout fingerprints
+// (binary_codec.h) use it. Lookups use hash_key below.
+constexpr uint64_t fnv1a(std::string_view s)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : s)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+// Little-endian value of the Bytes bytes at p; compilers turn it into one load.
+template <size_t Bytes>
+constexpr uint64_t load_bytes(const char* p)
+{
+    uint64_t w = 0;
+    for (size_t i = 0; i < Bytes; ++i) w |= uint64_t { static_cast<unsigned char>(p[i]) } << (8 * i);
+    return w;
+}
+
+// MurmurHash3 finalizer.
+constexpr uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Mixed 64-bit hash of s: whole words, then the last (possibly overlapping)
+// word, or for short keys two overlapping halves or three sampled bytes.
+constexpr uint64_t hash_key(std::string_view s)
+{
+    const char* p = s.data();
+    size_t n = s.size();
+    uint64_t h = n * 0x9E3779B97F4A7C15ULL;
+    if (n >= 8)
+    {
+        const char* const last = p + n - 8;
+        for (; p < last; p += 8)
+        {
+            h = (h ^ load_bytes<8>(p)) * 0x100000001b3ULL;
+            h ^= h >> 32;
+        }
+        h ^= load_bytes<8>(last);
+    }
+    else if (n >= 4)
+    {
+        h ^= load_bytes<4>(p) | load_bytes<4>(p + n - 4) << 32;
+    }
+    else if (n > 0)
+    {
+        h ^= load_bytes<1>(p) | load_bytes<1>(p + n / 2) << 8 | load_bytes<1>(p + n - 1) << 16;
+    }
+    return mix64(h);
+}
+
+// Maps 32 random bits onto [0, n) without a division.
+constexpr size_t reduce(uint64_t bits32, size_t n)
+{
+    return static_cast<size_t>((bits32 * n) >> 32);
+}
+
+} // namespace detail
+
+template <size_t N>
+class PerfectHash
+{
+    static_assert(N > 0, "PerfectHash needs at least one key");
+
+public:
+    // Builds the hash; valid() is false if two keys hash identically
+    // (duplicates, in practice).
+    constexpr explicit PerfectHash(const std::array<std::string_view, N>& keys)
+        : keys_(keys)
+    {
+        std::array<uint64_t, N> hashes {};
+        std::array<size_t, N> bucket_size {};
+        size_t largest = 0;
+        for (size_t i = 0; i < N; ++i)
+        {
+            hashes[i] = detail::hash_key(keys[i]);
+            const size_t b = bucket(hashes[i]);
+            if (++bucket_size[b] > largest) largest = bucket_size[b];
+        }
+
+        // Keys grouped by bucket (counting sort): bucket b owns members[first[b], first[b + 1]).
+        std::array<size_t, N + 1> first {};
+        for (size_t b = 0; b < N; ++b) first[b + 1] = first[b] + bucket_size[b];
+        std::array<size_t, N> members {};
+        std::array<size_t, N> fill {};
+        for (size_t i = 0; i < N; ++i)
+        {
+            const size_t b = bucket(hashes[i]);
+            members[first[b] + fill[b]++] = i;
+        }
+
+        std::array<bool, N> taken {};
+        for (size_t size = largest; size > 0; --size)
+        {
+            for (size_t b = 0; b < N; ++b)
+            {
+                if (bucket_size[b] != size) continue;
+                const size_t* m = &members[first[b]];
+
+                // Identical hashes can never be separated.
+                for (size_t x = 1; x < size; ++x)
+                {
+                    for (size_t y = 0; y < x; ++y)
+                    {
+                        if (hashes[m[x]] == hashes[m[y]]) return;
+                    }
+                }
+
+                // Try seeds until every member lands on a distinct free slot.
+                uint32_t seed = 1;
+                for (;; ++seed)
+                {
+                    if (seed == kMaxSeed) return;
+                    bool fits = true;
+                    for (size_t x = 0; x < size && fits; ++x)
+                    {
+                        const size_t s = slot(hashes[m[x]], seed);
+                        fits = !taken[s];
+                        for (size_t y = 0; y < x && fits; ++y)
+                        {
+                            fits = slot(hashes[m[y]], seed) != s;
+                        }
+                    }
+                    if (fits) break;
+                }
+
+                seeds_[b] = seed;
+                for (size_t x = 0; x < size; ++x)
+                {
+                    const size_t s = slot(hashes[m[x]], seed);
+                    taken[s] = true;
+                    slot_to_index_[s] = static_cast<uint32_t>(m[x]);
+                }
+            }
+        }
+        valid_ = true;
+    }
+
+    constexpr bool valid() const { return valid_; }
+
+    // Position of key in the array the hash was built from, or N if absent.
+    constexpr size_t find(std::string_view key) const
+    {
+        const uint64_t h = detail::hash_key(key);
+        const size_t i = slot_to_index_[slot(h, seeds_[bucket(h)])];
+        return keys_[i] == key ? i : N;
+    }
+
+private:
+    static constexpr uint32_t kMaxSeed = 1u << 20;
+
+    // The bucket takes the high half of the mixed hash; the slot the high half
+    // of its product with an odd per-seed multiplier.
+    static constexpr size_t bucket(uint64_t h) { return detail::reduce(h >> 32, N); }
+    static constexpr size_t slot(uint64_t h, uint32_t seed)
+    {
+        return detail::reduce(((h ^ seed) * (0x9E3779B97F4A7C15ULL + 2 * uint64_t { seed })) >> 32, N);
+    }
+
+    std::array<std::string_view, N> keys_ {};
+    std::array<uint32_t, N> seeds_ {};
+    std::array<uint32_t, N> slot_to_index_ {};
+    bool valid_ = false;
+};
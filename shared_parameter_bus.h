@@ -0,0 +1,347 @@
+#pragma once
+
+// Parameter values shared between processes through POSIX shared memory.
+//
+// One process create()s the segment and is its only writer, enforced by an
+// exclusive flock() on the segment held until close(); any number of
+// processes attach() read-only. The segment is a 64-byte header followed by
+// one cache-line-aligned slot per parameter, in ParameterID order:
+//
+//   header:  magic "PTB1" | layout fingerprint
+//   slot:    u32 sequence | payload words
+//
+// Each slot is a seqlock. The writer makes the sequence odd, stores the
+// payload and makes it even again, so readers never block or write shared
+// memory: they copy the payload and retry only if a write overlapped. The
+// sequence doubles as the parameter's version counter (completed writes =
+// sequence / 2), which readers can poll with a single load to see whether
+// anything changed. The writer validates every value before publishing it.
+// A writer that died mid-write leaves its slot's sequence odd. The kernel
+// drops a dead writer's lock, so once the next create() holds it no write
+// can be in flight, and it finishes that write, republishing the payload if it still
+// validates and the default otherwise.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "binary_codec.h"
+#include "concurrent_parameter_store.h"
+#include "parameter_error.h"
+#include "parameter_registry.h"
+#include "parameter_store.h"
+
+inline constexpr uint32_t kBusMagic = 0x31425450;   // "PTB1" little-endian
+inline constexpr size_t kBusHeaderSize = kCacheLineSize;
+
+namespace detail
+{
+
+template <typename Registry>
+constexpr size_t bus_payload_words(size_t i)
+{
+    return (Registry::table[i].size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+}
+
+// u32 sequence padded to 8 bytes, then the payload, rounded to a cache line.
+template <typename Registry>
+constexpr size_t bus_slot_size(size_t i)
+{
+    const size_t bytes = sizeof(uint64_t) * (1 + bus_payload_words<Registry>(i));
+    return (bytes + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+}
+
+template <typename Registry>
+constexpr size_t bus_max_payload_words()
+{
+    size_t m = 0;
+    for (size_t i = 0; i < Registry::size; ++i) m = std::max(m, bus_payload_words<Registry>(i));
+    return m;
+}
+
+} // namespace detail
+
+template <typename Registry>
+class SharedParameterBus
+{
+public:
+    using Store = ParameterStore<Registry>;
+
+    // Other processes see the same atomics only if they are plain memory.
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+                  "SharedParameterBus needs lock-free 32- and 64-bit atomics");
+
+    // Byte offset of each parameter's slot in the segment, indexed by
+    // ParameterID.
+    static constexpr std::array<size_t, Registry::size> slot_offsets = []
+    {
+        std::array<size_t, Registry::size> o {};
+        size_t at = kBusHeaderSize;
+        for (size_t i = 0; i < Registry::size; ++i)
+        {
+            o[i] = at;
+            at += detail::bus_slot_size<Registry>(i);
+        }
+        return o;
+    }();
+
+    static constexpr size_t segment_size =
+        slot_offsets[Registry::size - 1] + detail::bus_slot_size<Registry>(Registry::size - 1);
+
+    SharedParameterBus() = default;
+    SharedParameterBus(const SharedParameterBus&) = delete;
+    SharedParameterBus& operator=(const SharedParameterBus&) = delete;
+
+    ~SharedParameterBus()
+    {
+        close();
+    }
+
+    // Opens (creating if needed) the segment `name` ("/something") as its
+    // writer. A segment left by an earlier writer with the same layout keeps
+    // its values and versions, after repairing any slot that writer left
+    // mid-write; anything else starts over at the defaults. Returns false on
+    // errors (errno set), EWOULDBLOCK if another writer has it open.
+    bool create(const char* name)
+    {
+        if (!map(name, O_RDWR | O_CREAT, PROT_READ | PROT_WRITE)) return false;
+        writer_ = true;
+
+        auto& magic = atomic_at<uint32_t>(0);
+        if (magic.load(std::memory_order_acquire) == kBusMagic
+            && load_le<uint32_t>(base_ + sizeof(uint32_t)) == detail::snapshot_fingerprint<Registry>())
+        {
+            for (size_t i = 0; i < Registry::size; ++i) repair_slot(i);
+            return true;
+        }
+
+        magic.store(0, std::memory_order_relaxed);
+        std::memset(base_ + sizeof(uint32_t), 0, segment_size - sizeof(uint32_t));
+        store_le(detail::snapshot_fingerprint<Registry>(), base_ + sizeof(uint32_t));
+        const Store defaults;
+        for (size_t i = 0; i < Registry::size; ++i) write_slot(i, defaults.data() + Store::offsets[i]);
+        magic.store(kBusMagic, std::memory_order_release);
+        return true;
+    }
+
+    // Maps an existing segment read-only. Fails if it is missing, not yet
+    // initialised by its writer or laid out for a different registry.
+    bool attach(const char* name)
+    {
+        if (!map(name, O_RDONLY, PROT_READ)) return false;
+        if (atomic_at<uint32_t>(0).load(std::memory_order_acquire) != kBusMagic
+            || load_le<uint32_t>(base_ + sizeof(uint32_t)) != detail::snapshot_fingerprint<Registry>())
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close()
+    {
+        if (base_) ::munmap(base_, segment_size);
+        if (fd_ >= 0) ::close(fd_);
+        base_ = nullptr;
+        fd_ = -1;
+        writer_ = false;
+    }
+
+    // Removes the name; processes that still have it mapped are unaffected.
+    static bool unlink(const char* name)
+    {
+        return ::shm_unlink(name) == 0;
+    }
+
+    bool is_open() const { return base_ != nullptr; }
+    bool is_writer() const { return writer_; }
+
+    // Writer only: publishes v if ParameterTraits<T>::validate accepts it.
+    template <typename T>
+    bool set(const T& v)
+    {
+        if (!writer_ || !ParameterTraits<T>::validate(v)) return false;
+        write_slot(static_cast<size_t>(ParameterTraits<T>::id), &v);
+        return true;
+    }
+
+    // Writer only: parses all of `in` on top of the current value and
+    // publishes it if it validates. ReadOnly on an attached bus.
+    ParameterResult parse(ParameterID id, std::string_view in)
+    {
+        if (!writer_) return { ParameterError::ReadOnly };
+        if (!Registry::contains_id(id)) return { ParameterError::UnknownParameter };
+        const size_t i = static_cast<size_t>(id);
+        uint64_t scratch[kMaxWords];
+        read_slot(i, scratch);
+        const ParameterResult r = Registry::table[i].parse(in, scratch);
+        if (r) write_slot(i, scratch);
+        return r;
+    }
+
+    // Writer only: publishes every parameter of store.
+    void publish(const Store& store)
+    {
+        if (!writer_) return;
+        for (size_t i = 0; i < Registry::size; ++i) write_slot(i, store.data() + Store::offsets[i]);
+    }
+
+    // Lock-free read of the current value, and optionally of its version.
+    template <typename T>
+    T get(uint32_t* version = nullptr) const
+    {
+        T v;
+        const uint32_t seq = read_slot(static_cast<size_t>(ParameterTraits<T>::id), &v);
+        if (version) *version = seq / 2;
+        return v;
+    }
+
+    // Number of completed writes to id; one acquire load.
+    uint32_t version(ParameterID id) const
+    {
+        if (!Registry::contains_id(id)) return 0;
+        return atomic_at<uint32_t>(slot_offsets[static_cast<size_t>(id)]).load(std::memory_order_acquire) / 2;
+    }
+
+    // True (and seen updated) if id was written since version `seen`.
+    bool changed(ParameterID id, uint32_t& seen) const
+    {
+        const uint32_t v = version(id);
+        if (v == seen) return false;
+        seen = v;
+        return true;
+    }
+
+    // Copies every parameter into store, each one a consistent value.
+    void snapshot(Store& store) const
+    {
+        for (size_t i = 0; i < Registry::size; ++i) read_slot(i, store.data() + Store::offsets[i]);
+    }
+
+private:
+    static constexpr size_t kMaxWords = detail::bus_max_payload_words<Registry>();
+
+    static constexpr size_t payload_words(size_t i)
+    {
+        return detail::bus_payload_words<Registry>(i);
+    }
+
+    bool map(const char* name, int flags, int prot)
+    {
+        close();
+        fd_ = ::shm_open(name, flags, 0644);
+        if (fd_ < 0) return false;
+
+        // Writers exclude each other before touching the size or contents.
+        if ((flags & O_CREAT) != 0 && ::flock(fd_, LOCK_EX | LOCK_NB) != 0)
+        {
+            const int error = errno;
+            close();
+            errno = error;
+            return false;
+        }
+
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0
+            || (static_cast<size_t>(st.st_size) < segment_size
+                && ((flags & O_CREAT) == 0 || ::ftruncate(fd_, segment_size) != 0)))
+        {
+            close();
+            return false;
+        }
+
+        void* map = ::mmap(nullptr, segment_size, prot, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED)
+        {
+            close();
+            return false;
+        }
+        base_ = static_cast<unsigned char*>(map);
+        return true;
+    }
+
+    template <typename W>
+    std::atomic<W>& atomic_at(size_t offset) const
+    {
+        return *reinterpret_cast<std::atomic<W>*>(base_ + offset);
+    }
+
+    void write_slot(size_t i, const void* value)
+    {
+        uint64_t buf[kMaxWords] {};
+        std::memcpy(buf, value, Registry::table[i].size);
+
+        auto& seq = atomic_at<uint32_t>(slot_offsets[i]);
+        const uint32_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t w = 0; w < payload_words(i); ++w)
+        {
+            atomic_at<uint64_t>(slot_offsets[i] + sizeof(uint64_t) * (w + 1)).store(buf[w], std::memory_order_relaxed);
+        }
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    // Completes a write interrupted by a dead writer: an odd sequence is
+    // made even again around the payload it left, or the default if that
+    // payload no longer validates.
+    void repair_slot(size_t i)
+    {
+        auto& seq = atomic_at<uint32_t>(slot_offsets[i]);
+        const uint32_t s = seq.load(std::memory_order_relaxed);
+        if ((s & 1) == 0) return;
+
+        const ParameterOps& ops = Registry::table[i];
+        uint64_t buf[kMaxWords];
+        for (size_t w = 0; w < payload_words(i); ++w)
+        {
+            buf[w] = atomic_at<uint64_t>(slot_offsets[i] + sizeof(uint64_t) * (w + 1)).load(std::memory_order_relaxed);
+        }
+        if (!ops.validate(buf)) std::memcpy(buf, ops.default_value, ops.size);
+        for (size_t w = 0; w < payload_words(i); ++w)
+        {
+            atomic_at<uint64_t>(slot_offsets[i] + sizeof(uint64_t) * (w + 1)).store(buf[w], std::memory_order_relaxed);
+        }
+        seq.store(s + 1, std::memory_order_release);
+    }
+
+    // Returns the (even) sequence the copy was taken at.
+    uint32_t read_slot(size_t i, void* out) const
+    {
+        uint64_t buf[kMaxWords];
+        const auto& seq = atomic_at<uint32_t>(slot_offsets[i]);
+        uint32_t before;
+        for (;;)
+        {
+            before = seq.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                detail::cpu_relax();
+                continue;
+            }
+            for (size_t w = 0; w < payload_words(i); ++w)
+            {
+                buf[w] = atomic_at<uint64_t>(slot_offsets[i] + sizeof(uint64_t) * (w + 1)).load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == before) break;
+        }
+        std::memcpy(out, buf, Registry::table[i].size);
+        return before;
+    }
+
+    unsigned char* base_ = nullptr;
+    int fd_ = -1;
+    bool writer_ = false;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+// Range checks over contiguous float arrays, used by batch validation.
+//
+// A value passes when lo <= v <= hi; NaN never passes, exactly like the
+// scalar comparison. Blocks of 8 (AVX2) or 4 (SSE2) are compared against
+// broadcast bounds and reduced with movemask; whatever the target lacks
+// falls back to a plain loop.
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace detail
+{
+
+#if defined(__AVX2__)
+inline constexpr size_t kRangeLanes = 8;
+
+// Bit i set when p[i] fails, for kRangeLanes values.
+inline uint32_t out_of_range_bits(const float* p, __m256 lo, __m256 hi)
+{
+    const __m256 x = _mm256_loadu_ps(p);
+    const __m256 ok = _mm256_and_ps(_mm256_cmp_ps(x, lo, _CMP_GE_OQ), _mm256_cmp_ps(x, hi, _CMP_LE_OQ));
+    return ~static_cast<uint32_t>(_mm256_movemask_ps(ok)) & 0xFFu;
+}
+
+inline __m256 range_bound(float v)
+{
+    return _mm256_set1_ps(v);
+}
+#elif defined(__SSE2__)
+inline constexpr size_t kRangeLanes = 4;
+
+inline uint32_t out_of_range_bits(const float* p, __m128 lo, __m128 hi)
+{
+    const __m128 x = _mm_loadu_ps(p);
+    const __m128 ok = _mm_and_ps(_mm_cmpge_ps(x, lo), _mm_cmple_ps(x, hi));
+    return ~static_cast<uint32_t>(_mm_movemask_ps(ok)) & 0xFu;
+}
+
+inline __m128 range_bound(float v)
+{
+    return _mm_set1_ps(v);
+}
+#endif
+
+inline bool in_range(float v, float lo, float hi)
+{
+    return v >= lo && v <= hi;
+}
+
+} // namespace detail
+
+// Index of the first v[i] outside [lo, hi], or n if all pass.
+inline size_t find_out_of_range(const float* v, size_t n, float lo, float hi)
+{
+    size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    const auto vlo = detail::range_bound(lo);
+    const auto vhi = detail::range_bound(hi);
+    for (; n - i >= detail::kRangeLanes; i += detail::kRangeLanes)
+    {
+        const uint32_t bits = detail::out_of_range_bits(v + i, vlo, vhi);
+        if (bits) return i + static_cast<size_t>(__builtin_ctz(bits));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        if (!detail::in_range(v[i], lo, hi)) return i;
+    }
+    return n;
+}
+
+// Sets bit i % 64 of mask[i / 64] for every v[i] outside [lo, hi] and clears
+// the rest; mask must hold (n + 63) / 64 words. Returns the number that fail.
+inline size_t out_of_range_mask(const float* v, size_t n, float lo, float hi, uint64_t* mask)
+{
+    for (size_t w = 0; w < (n + 63) / 64; ++w) mask[w] = 0;
+    size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    const auto vlo = detail::range_bound(lo);
+    const auto vhi = detail::range_bound(hi);
+    for (; n - i >= detail::kRangeLanes; i += detail::kRangeLanes)
+    {
+        mask[i / 64] |= uint64_t { detail::out_of_range_bits(v + i, vlo, vhi) } << (i % 64);
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        if (!detail::in_range(v[i], lo, hi)) mask[i / 64] |= uint64_t { 1 } << (i % 64);
+    }
+    size_t failed = 0;
+    for (size_t w = 0; w < (n + 63) / 64; ++w) failed += static_cast<size_t>(__builtin_popcountll(mask[w]));
+    return failed;
+}
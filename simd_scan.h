@@ -0,0 +1,59 @@
+#pragma once
+
+// Byte scanning helpers shared by the text loaders.
+//
+// find_char() locates the next occurrence of a delimiter 16 bytes at a time
+// with SSE2 compare + movemask where available, and falls back to memchr.
+// find_any<Cs...>() does the same for a small set of delimiters, OR-ing one
+// compare per character.
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// First occurrence of c in [p, end), or end.
+inline const char* find_char(const char* p, const char* end, char c)
+{
+#if defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi8(c);
+    for (; end - p >= 16; p += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask) return p + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+    for (; p != end; ++p)
+    {
+        if (*p == c) return p;
+    }
+    return end;
+#else
+    const void* hit = p == end ? nullptr : std::memchr(p, c, static_cast<size_t>(end - p));
+    return hit ? static_cast<const char*>(hit) : end;
+#endif
+}
+
+// First byte of [p, end) equal to any of Cs, or end.
+template <char... Cs>
+inline const char* find_any(const char* p, const char* end)
+{
+    static_assert(sizeof...(Cs) > 0, "find_any needs at least one delimiter");
+#if defined(__SSE2__)
+    for (; end - p >= 16; p += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_setzero_si128();
+        ((hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8(Cs)))), ...);
+        const int mask = _mm_movemask_epi8(hits);
+        if (mask) return p + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+#endif
+    for (; p != end; ++p)
+    {
+        if (((*p == Cs) || ...)) return p;
+    }
+    return end;
+}
@@ -0,0 +1,113 @@
+// ConfigStreamParser must not depend on where the chunks split: the text is
+// fed whole, cut once at every offset, and one byte at a time, and each run
+// must produce the same updates and the same errors at the same offsets.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "config_stream_parser.h"
+#include "parameters.h"
+#include "test_support.h"
+
+namespace
+{
+
+struct Event
+{
+    bool error;
+    size_t line;
+    size_t offset;          // errors only
+    uint8_t kind;           // ConfigError, or the ParameterID of an update
+    uint8_t cause;          // ParameterError
+    float value;            // updates only: the parameter's float
+
+    bool operator==(const Event& o) const
+    {
+        return error == o.error && line == o.line && offset == o.offset && kind == o.kind
+            && cause == o.cause && std::memcmp(&value, &o.value, sizeof(value)) == 0;
+    }
+};
+
+using Parser = ConfigStreamParser<Parameters>;
+
+// Feeds text cut at the given offsets (ascending) and records every event.
+std::vector<Event> run(Parser& parser, std::string_view text, const std::vector<size_t>& cuts)
+{
+    std::vector<Event> events;
+    auto on_update = [&](ParameterID id, const void* v)
+    {
+        float f;
+        std::memcpy(&f, v, sizeof(f));
+        events.push_back({ false, parser.line(), 0, static_cast<uint8_t>(id), 0, f });
+    };
+    auto on_error = [&](const ConfigLineError& e)
+    {
+        events.push_back({ true, e.line, e.offset, static_cast<uint8_t>(e.error), static_cast<uint8_t>(e.cause.error), 0.0f });
+    };
+
+    size_t at = 0;
+    for (size_t cut : cuts)
+    {
+        parser.feed(text.substr(at, cut - at), on_update, on_error);
+        at = cut;
+    }
+    parser.feed(text.substr(at), on_update, on_error);
+    parser.finish(on_update, on_error);
+    return events;
+}
+
+} // namespace
+
+size_t run_config_stream_tests()
+{
+    static_assert(Parser::kTokenCapacity == 64, "the long values below assume MaxValue 64");
+
+    const std::string exactly_max = "1" + std::string(61, '0') + ".5";     // 64 characters
+    const std::string too_long = "1" + std::string(62, '0') + ".5";        // 65 characters
+    const std::string text =
+        "# comment\n"
+        "TemperatureSetpoint = 45.5\r\n"
+        "\n"
+        "HighTemperatureAlarm=200\n"
+        "Humidity=40\n"
+        "NoEquals\n"
+        "TemperatureSetpoint=\n"
+        "TemperatureSetpoint=4x\n"
+        "TemperatureSetpoint=" + exactly_max + "\n"
+        "TemperatureSetpoint=   " + too_long + "   \n"
+        "HighTemperatureAlarm=\t" + std::string(70, '9') + "\n"
+        "HighTemperatureAlarm=\t85.25   ";
+
+    static Parser parser;
+    size_t failures = 0;
+    const std::vector<Event> whole = run(parser, text, {});
+
+    size_t errors = 0, too_long_errors = 0;
+    for (const Event& e : whole)
+    {
+        errors += e.error;
+        too_long_errors += e.error && e.kind == static_cast<uint8_t>(ConfigError::ValueTooLong);
+    }
+    PT_CHECK(whole.size() == 10, failures);
+    PT_CHECK(errors == 8, failures);
+    PT_CHECK(too_long_errors == 2, failures);
+
+    for (size_t cut = 1; cut < text.size(); ++cut)
+    {
+        if (run(parser, text, { cut }) != whole)
+        {
+            ++failures;
+            std::cerr << "config_stream: result differs when split at byte " << cut << "\n";
+        }
+    }
+
+    std::vector<size_t> every_byte;
+    for (size_t cut = 1; cut < text.size(); ++cut) every_byte.push_back(cut);
+    PT_CHECK(run(parser, text, every_byte) == whole, failures);
+    return failures;
+}
@@ -0,0 +1,107 @@
+// Golden-output tests: format_float_fixed<P> against snprintf("%.<P>f") and
+// format_float against std::to_chars, on edge values plus a seeded sample.
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string_view>
+
+#include "float_format.h"
+#include "test_support.h"
+
+namespace
+{
+
+float from_bits(uint32_t bits)
+{
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+template <int Precision>
+bool matches_printf(float v, size_t& failures)
+{
+    char expected[64];
+    char actual[64];
+    char format[8];
+    std::snprintf(format, sizeof(format), "%%.%df", Precision);
+    const int n = std::snprintf(expected, sizeof(expected), format, static_cast<double>(v));
+    const FloatFormatResult r = format_float_fixed<Precision>(actual, actual + sizeof(actual), v);
+    if (r.ec == FloatFormatError::None && std::string_view(actual, static_cast<size_t>(r.ptr - actual)) == std::string_view(expected, static_cast<size_t>(n)))
+    {
+        return true;
+    }
+    if (failures++ < 10)
+    {
+        std::cerr << "format_float_fixed<" << Precision << ">(" << expected << "): got \""
+                  << std::string_view(actual, static_cast<size_t>(r.ptr - actual)) << "\"\n";
+    }
+    return false;
+}
+
+bool matches_to_chars(float v, size_t& failures)
+{
+    char expected[64];
+    char actual[64];
+    const std::to_chars_result e = std::to_chars(expected, expected + sizeof(expected), v);
+    const FloatFormatResult r = format_float(actual, actual + sizeof(actual), v);
+    if (r.ec == FloatFormatError::None && std::string_view(actual, static_cast<size_t>(r.ptr - actual)) == std::string_view(expected, static_cast<size_t>(e.ptr - expected)))
+    {
+        return true;
+    }
+    if (failures++ < 10)
+    {
+        std::cerr << "format_float(" << std::string_view(expected, static_cast<size_t>(e.ptr - expected)) << "): got \""
+                  << std::string_view(actual, static_cast<size_t>(r.ptr - actual)) << "\"\n";
+    }
+    return false;
+}
+
+template <typename Check>
+void for_each_sample(Check&& check)
+{
+    constexpr float kEdges[] =
+    {
+        0.0f, -0.0f, 0.005f, -0.005f, 0.015f, 0.025f, 0.125f, 0.375f, 1.005f, 2.675f,
+        0.995f, 9.995f, 99.995f, 99.99f, 100.0f, 150.0f, 37.5f, 42.0f, 85.25f, 1e-10f,
+        0.5f, 1.5f, 2.5f, -2.5f, 16777216.0f, 16777217.0f, 4294967296.0f, 1e20f, 1e38f,
+        std::numeric_limits<float>::min(),
+        std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::max(),
+        -std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(),
+    };
+    for (float v : kEdges) check(v);
+
+    // Every float in a parameter-like range, stepped in ulps, then random
+    // bit patterns across the whole domain.
+    for (uint32_t bits = 0x3C000000; bits < 0x43200000; bits += 97) check(from_bits(bits));
+    std::mt19937 rng(20250828);
+    for (int i = 0; i < 1000000; ++i) check(from_bits(static_cast<uint32_t>(rng())));
+}
+
+} // namespace
+
+size_t run_float_format_tests()
+{
+    size_t failures = 0;
+    for_each_sample([&](float v)
+    {
+        matches_printf<2>(v, failures);
+        matches_printf<0>(v, failures);
+        matches_printf<6>(v, failures);
+        if (v == v) matches_to_chars(v, failures);
+    });
+
+    // Too small a buffer reports an error instead of truncating.
+    char small[4];
+    PT_CHECK(format_float_fixed<2>(small, small + sizeof(small), 100.0f).ec == FloatFormatError::BufferTooSmall, failures);
+    return failures;
+}
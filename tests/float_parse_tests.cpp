@@ -0,0 +1,195 @@
+// parse_float against the C library: everything format_float writes reads
+// back to the same bits, decimal halfway points (and their neighbours) with
+// more than 19 digits round like strtof, and the non-number spellings and
+// malformed inputs come back with the right error and stop position.
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "float_format.h"
+#include "float_parse.h"
+#include "parameters.h"
+#include "test_support.h"
+
+namespace
+{
+
+float from_bits(uint32_t bits)
+{
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+uint32_t to_bits(float v)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+bool round_trips(float v, size_t& failures)
+{
+    char buf[64];
+    const FloatFormatResult f = format_float(buf, buf + sizeof(buf), v);
+    float back = 0.0f;
+    const FloatParseResult r = parse_float(std::string_view(buf, static_cast<size_t>(f.ptr - buf)), back);
+    if (r.ec == FloatParseError::None && r.ptr == f.ptr && to_bits(back) == to_bits(v)) return true;
+    ++failures;
+    std::cerr << "float_parse: " << std::string_view(buf, static_cast<size_t>(f.ptr - buf))
+              << " does not read back as bits 0x" << std::hex << to_bits(v) << std::dec << "\n";
+    return false;
+}
+
+// Exact decimal expansion of d (every binary double has one), trailing zeros
+// of the mantissa dropped: "d.ddd...e+XX".
+std::string exact_decimal(double d)
+{
+    char buf[1200];
+    std::snprintf(buf, sizeof(buf), "%.1100e", d);
+    std::string s(buf);
+    const size_t e = s.find('e');
+    size_t end = e;
+    while (s[end - 1] == '0') --end;
+    if (s[end - 1] == '.') --end;
+    return s.substr(0, end) + s.substr(e);
+}
+
+size_t significant_digits(const std::string& s)
+{
+    size_t n = 0;
+    for (char c : s.substr(0, s.find('e'))) n += c >= '0' && c <= '9';
+    return n;
+}
+
+// The midpoint between v and the next float up, and the doubles just either
+// side of it: all exact in binary64, all printed in full.
+bool halfway_matches_strtof(float v, size_t& failures)
+{
+    const double mid = (static_cast<double>(v) + static_cast<double>(std::nextafter(v, std::numeric_limits<float>::infinity()))) / 2.0;
+    bool ok = true;
+    for (double d : { std::nextafter(mid, 0.0), mid, std::nextafter(mid, 1e300) })
+    {
+        const std::string text = exact_decimal(d);
+        if (significant_digits(text) <= 19) continue;
+        errno = 0;
+        const float expected = std::strtof(text.c_str(), nullptr);
+        if (errno == ERANGE) continue;
+        float actual = 0.0f;
+        const FloatParseResult r = parse_float(text, actual);
+        if (r.ec == FloatParseError::None && r.ptr == text.data() + text.size() && to_bits(actual) == to_bits(expected)) continue;
+        ++failures;
+        ok = false;
+        std::cerr << "float_parse: " << text << " -> 0x" << std::hex << to_bits(actual)
+                  << ", strtof gives 0x" << to_bits(expected) << std::dec << "\n";
+    }
+    return ok;
+}
+
+size_t special_inputs()
+{
+    size_t failures = 0;
+    float v = 0.0f;
+    auto parse = [&v](std::string_view in) { return parse_float(in, v); };
+
+    FloatParseResult r = parse("");
+    PT_CHECK(r.ec == FloatParseError::Empty, failures);
+
+    for (std::string_view in : { "inf", "INF", "+Infinity", "-infinity" })
+    {
+        r = parse(in);
+        PT_CHECK(r.ec == FloatParseError::None && r.ptr == in.data() + in.size(), failures);
+        PT_CHECK(std::isinf(v) && std::signbit(v) == (in[0] == '-'), failures);
+    }
+    const std::string_view infx = "infinit";
+    r = parse(infx);
+    PT_CHECK(r.ec == FloatParseError::None && r.ptr == infx.data() + 3 && std::isinf(v), failures);
+
+    for (std::string_view in : { "nan", "NaN", "-nan" })
+    {
+        r = parse(in);
+        PT_CHECK(r.ec == FloatParseError::None && r.ptr == in.data() + in.size() && std::isnan(v), failures);
+    }
+
+    for (std::string_view in : { "-", "+", ".", "e5", "x1", "in", "na", " 1" })
+    {
+        r = parse(in);
+        PT_CHECK(r.ec == FloatParseError::InvalidCharacter && r.ptr == in.data(), failures);
+    }
+
+    // The longest number is taken; whatever follows is left for the caller.
+    const std::string_view trailing[] = { "1.5x", "2e", "3e+", "4.25 ", "5..0", "6e2e2" };
+    const size_t stop[] = { 3, 1, 1, 4, 2, 3 };
+    for (size_t i = 0; i < 6; ++i)
+    {
+        r = parse(trailing[i]);
+        PT_CHECK(r.ec == FloatParseError::None && r.ptr == trailing[i].data() + stop[i], failures);
+    }
+
+    for (std::string_view in : { "1e39", "-3.5e38", "1e-46", "1e99999" })
+    {
+        PT_CHECK(parse(in).ec == FloatParseError::OutOfRange, failures);
+    }
+    PT_CHECK(parse("1e-45").ec == FloatParseError::None && v == from_bits(1), failures);
+    PT_CHECK(parse("-0").ec == FloatParseError::None && v == 0.0f && std::signbit(v), failures);
+
+    // Through the trait, a number followed by anything is rejected at the stop.
+    TemperatureSetpoint t { 0.0f };
+    using Traits = ParameterTraits<TemperatureSetpoint>;
+    PT_CHECK(Traits::parse("", t).error == ParameterError::Empty, failures);
+    PT_CHECK(Traits::parse("abc", t).error == ParameterError::InvalidCharacter, failures);
+    ParameterResult pr = Traits::parse("45.5x", t);
+    PT_CHECK(pr.error == ParameterError::TrailingCharacters && pr.offset == 4, failures);
+    PT_CHECK(Traits::parse("1e39", t).error == ParameterError::OutOfRange, failures);
+    PT_CHECK(Traits::parse("nan", t).error == ParameterError::NotANumber, failures);
+    PT_CHECK(Traits::parse("inf", t).error == ParameterError::AboveMaximum, failures);
+    return failures;
+}
+
+} // namespace
+
+size_t run_float_parse_tests()
+{
+    size_t failures = 0;
+
+    const float edges[] = {
+        0.0f, -0.0f, 1.0f, -1.0f, 0.1f, 1.0f / 3.0f, 37.5f, 1e10f, 16777216.0f, 16777217.0f,
+        std::numeric_limits<float>::min(), std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::lowest(), std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::epsilon(), std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(), from_bits(0x007fffffu), from_bits(0x00800001u),
+    };
+    for (float v : edges) round_trips(v, failures);
+
+    std::mt19937 rng(1);
+    constexpr uint32_t kMaxFinite = 0x7f7fffffu;
+    for (int i = 0; i < 200000 && failures < 20; ++i)
+    {
+        const uint32_t bits = rng();
+        if ((bits & 0x7fffffffu) > kMaxFinite) continue;
+        round_trips(from_bits(bits), failures);
+    }
+
+    for (float v : { 1.0f, 0.1f, 37.5f, 1e-40f, 3e38f, 16777216.0f, from_bits(1), from_bits(0x7f7ffffeu) })
+    {
+        halfway_matches_strtof(v, failures);
+    }
+    for (int i = 0; i < 20000 && failures < 20; ++i)
+    {
+        const uint32_t bits = rng() & 0x7fffffffu;
+        if (bits >= kMaxFinite) continue;
+        halfway_matches_strtof(from_bits(bits), failures);
+    }
+
+    failures += special_inputs();
+    return failures;
+}
@@ -0,0 +1,174 @@
+// ParameterJournal recovery: replay after reopen, a torn or corrupt tail cut
+// off (and appends continuing cleanly after it), and compact() running on
+// its own thread while another appends, with the reopened state equal to
+// the last values appended.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "parameter_journal.h"
+#include "parameters.h"
+#include "test_support.h"
+
+namespace
+{
+
+using Journal = ParameterJournal<Parameters>;
+using Store = ParameterStore<Parameters>;
+
+constexpr size_t kRecordSize = kJournalRecordHeaderSize + sizeof(float);
+
+off_t file_size(const std::string& path)
+{
+    struct stat st {};
+    return ::stat(path.c_str(), &st) == 0 ? st.st_size : -1;
+}
+
+bool append_raw(const std::string& path, const unsigned char* bytes, size_t n)
+{
+    const int fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+    if (fd < 0) return false;
+    const bool ok = ::write(fd, bytes, n) == static_cast<ssize_t>(n);
+    ::close(fd);
+    return ok;
+}
+
+void remove_files(const std::string& base)
+{
+    for (const char* suffix : { ".journal", ".snapshot", ".journal.tmp", ".snapshot.tmp" })
+    {
+        ::unlink((base + suffix).c_str());
+    }
+}
+
+float setpoint_after_open(Journal& journal, const std::string& base)
+{
+    Store state;
+    if (!journal.open(base.c_str())) return -1.0f;
+    journal.snapshot(state);
+    return state.get<TemperatureSetpoint>().value;
+}
+
+size_t torn_tail(const std::string& base)
+{
+    const std::string path = base + ".journal";
+    size_t failures = 0;
+    {
+        Journal journal;
+        PT_CHECK(journal.open(base.c_str()), failures);
+        PT_CHECK(journal.append(TemperatureSetpoint { 41.0f }), failures);
+        PT_CHECK(journal.commit(), failures);
+    }
+    const off_t intact = file_size(path);
+    PT_CHECK(intact == static_cast<off_t>(kJournalHeaderSize + kRecordSize), failures);
+
+    // A crash in the middle of writing the next record.
+    const unsigned char partial[kRecordSize / 2] = { 0, 0, 1, 0 };
+    PT_CHECK(append_raw(path, partial, sizeof(partial)), failures);
+    {
+        Journal journal;
+        PT_CHECK(setpoint_after_open(journal, base) == 41.0f, failures);
+        PT_CHECK(journal.records() == 1, failures);
+        PT_CHECK(file_size(path) == intact, failures);
+
+        PT_CHECK(journal.append(TemperatureSetpoint { 42.0f }), failures);
+        PT_CHECK(journal.commit(), failures);
+    }
+    {
+        Journal journal;
+        PT_CHECK(setpoint_after_open(journal, base) == 42.0f, failures);
+        PT_CHECK(journal.records() == 2, failures);
+    }
+
+    // A whole record whose CRC does not match is cut off the same way.
+    unsigned char corrupt[kRecordSize] = {};
+    store_le(static_cast<uint16_t>(ParameterID::TemperatureSetpoint), corrupt);
+    store_le(ParameterTraits<TemperatureSetpoint>::schema_version, corrupt + 2);
+    store_le(43.0f, corrupt + kJournalRecordHeaderSize);
+    PT_CHECK(append_raw(path, corrupt, sizeof(corrupt)), failures);
+    {
+        Journal journal;
+        PT_CHECK(setpoint_after_open(journal, base) == 42.0f, failures);
+        PT_CHECK(file_size(path) == static_cast<off_t>(kJournalHeaderSize + 2 * kRecordSize), failures);
+    }
+    return failures;
+}
+
+// One round: appends while compact() loops on another thread. The last
+// values go in just after a compaction has restarted, most likely while it is
+// writing its snapshot, and the compactor then stops, so nothing folds them in
+// later: they survive only if the journal rewrite kept them.
+size_t compact_round(const std::string& base, uint32_t round)
+{
+    constexpr uint32_t kAppends = 2000;
+    size_t failures = 0;
+    std::atomic<bool> appending { true };
+    std::atomic<size_t> compactions { 0 };
+    std::atomic<size_t> failed { 0 };
+    float last = 0.0f, last_alarm = 0.0f;
+    {
+        Journal journal;
+        PT_CHECK(journal.open(base.c_str()), failures);
+
+        std::thread compactor([&]
+        {
+            while (appending.load(std::memory_order_acquire))
+            {
+                if (journal.compact()) compactions.fetch_add(1, std::memory_order_release);
+                else failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        for (uint32_t i = 1; i <= kAppends; ++i)
+        {
+            last = static_cast<float>((i + round) % 1000) / 10.0f;
+            if (!journal.append(TemperatureSetpoint { last })) failed.fetch_add(1);
+            if (i % 3 == 0)
+            {
+                last_alarm = last + 50.0f;
+                if (!journal.append(HighTemperatureAlarm { last_alarm })) failed.fetch_add(1);
+            }
+            if (i % 64 == 0 && !journal.commit()) failed.fetch_add(1);
+        }
+        const size_t seen = compactions.load(std::memory_order_acquire);
+        while (compactions.load(std::memory_order_acquire) == seen) std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        last = 12.25f + static_cast<float>(round);
+        last_alarm = 112.25f + static_cast<float>(round);
+        if (!journal.append(TemperatureSetpoint { last }) || !journal.append(HighTemperatureAlarm { last_alarm })) failed.fetch_add(1);
+        PT_CHECK(journal.commit(), failures);
+        appending.store(false, std::memory_order_release);
+        compactor.join();
+    }
+    PT_CHECK(failed.load() == 0, failures);
+
+    Journal journal;
+    Store state;
+    PT_CHECK(journal.open(base.c_str()), failures);
+    journal.snapshot(state);
+    PT_CHECK(state.get<TemperatureSetpoint>().value == last, failures);
+    PT_CHECK(state.get<HighTemperatureAlarm>().threshold == last_alarm, failures);
+    return failures;
+}
+
+} // namespace
+
+size_t run_journal_tests()
+{
+    const std::string base = "/tmp/PropertyTraitsTests.journal." + std::to_string(::getpid());
+    size_t failures = 0;
+
+    remove_files(base);
+    failures += torn_tail(base);
+    remove_files(base);
+    for (uint32_t round = 0; round < 8; ++round) failures += compact_round(base, round);
+    remove_files(base);
+    return failures;
+}
@@ -0,0 +1,132 @@
+// load_json_config on well-formed and broken documents: values of registered
+// keys land in the store, unknown keys (nested containers included) and
+// escaped keys are skipped, a registered key holding a container or a bad
+// value reports InvalidValue and loading goes on, and a malformed document
+// reports Syntax at the offending byte and stops.
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "json_config.h"
+#include "parameter_store.h"
+#include "parameters.h"
+#include "test_support.h"
+
+namespace
+{
+
+using Store = ParameterStore<Parameters>;
+
+struct Loaded
+{
+    ConfigParseResult result;
+    std::vector<ConfigLineError> errors;
+    Store store;
+};
+
+Loaded load(std::string_view json)
+{
+    Loaded out;
+    out.result = load_json_config(json, out.store, [&out](const ConfigLineError& e) { out.errors.push_back(e); });
+    return out;
+}
+
+bool one_error(const Loaded& l, ConfigError error, size_t line, size_t offset)
+{
+    return l.result.failed == 1 && l.errors.size() == 1 && l.errors[0].error == error
+        && l.errors[0].line == line && l.errors[0].offset == offset;
+}
+
+constexpr float kDefaultSetpoint = ParameterTraits<TemperatureSetpoint>::default_v.value;
+
+} // namespace
+
+size_t run_json_config_tests()
+{
+    size_t failures = 0;
+
+    // Registered values as numbers and as strings; unknown keys skipped
+    // however deeply their values nest, brackets and quotes inside strings
+    // included.
+    {
+        const Loaded l = load("{\n"
+                              "  \"zones\": [ { \"a\": [1, 2, {\"b\": \"]}\"}] }, [] ],\n"
+                              "  \"TemperatureSetpoint\": 45.5,\n"
+                              "  \"meta\": { \"note\": \"say \\\"hi\\\" {\", \"x\": { \"y\": [] } },\n"
+                              "  \"HighTemperatureAlarm\": \"90\"\n"
+                              "}\n");
+        PT_CHECK(l.result.applied == 2 && l.result.failed == 0 && l.errors.empty(), failures);
+        PT_CHECK(l.store.get<TemperatureSetpoint>().value == 45.5f, failures);
+        PT_CHECK(l.store.get<HighTemperatureAlarm>().threshold == 90.0f, failures);
+    }
+    {
+        const Loaded l = load(" { } ");
+        PT_CHECK(l.result.applied == 0 && l.result.failed == 0, failures);
+    }
+
+    // A key spelled with an escape never matches, even if it decodes to a
+    // registered name; its value is skipped.
+    {
+        const Loaded l = load("{\"Temperature\\u0053etpoint\": 10, \"Temp\\\"\": 11}");
+        PT_CHECK(l.result.applied == 0 && l.result.failed == 0, failures);
+        PT_CHECK(l.store.get<TemperatureSetpoint>().value == kDefaultSetpoint, failures);
+    }
+
+    // InvalidValue: a container under a registered key, a value the trait
+    // rejects, a value that fails validate; the keys after them still load.
+    {
+        const std::string_view json = "{\"TemperatureSetpoint\": {\"value\": 1},\n"
+                                      " \"HighTemperatureAlarm\": [90],\n"
+                                      " \"TemperatureSetpoint\": \"4x\",\n"
+                                      " \"TemperatureSetpoint\": 500,\n"
+                                      " \"HighTemperatureAlarm\": 95}";
+        const Loaded l = load(json);
+        PT_CHECK(l.result.applied == 1 && l.result.failed == 4 && l.errors.size() == 4, failures);
+        for (const ConfigLineError& e : l.errors) PT_CHECK(e.error == ConfigError::InvalidValue, failures);
+        if (l.errors.size() == 4)
+        {
+            PT_CHECK(l.errors[0].line == 1 && l.errors[0].offset == json.find('{', 1), failures);
+            PT_CHECK(l.errors[1].line == 2 && l.errors[1].offset == json.find('['), failures);
+            PT_CHECK(l.errors[2].line == 3 && l.errors[2].offset == json.find("x\""), failures);
+            PT_CHECK(l.errors[2].cause.error == ParameterError::TrailingCharacters, failures);
+            PT_CHECK(l.errors[3].line == 4 && l.errors[3].cause.error == ParameterError::AboveMaximum, failures);
+        }
+        PT_CHECK(l.store.get<TemperatureSetpoint>().value == kDefaultSetpoint, failures);
+        PT_CHECK(l.store.get<HighTemperatureAlarm>().threshold == 95.0f, failures);
+    }
+
+    // Syntax: reported once at the offending byte, loading stops there and
+    // values before it stay applied.
+    {
+        const std::string_view json = "{\"TemperatureSetpoint\": 40,\n\"HighTemperatureAlarm\": 90,\n}";
+        const Loaded l = load(json);
+        PT_CHECK(one_error(l, ConfigError::Syntax, 3, json.size() - 1), failures);
+        PT_CHECK(l.result.applied == 2 && l.store.get<TemperatureSetpoint>().value == 40.0f, failures);
+    }
+    {
+        const std::string_view json = "{\"TemperatureSetpoint\": 40, \"HighTemperatureAlarm\": \"90}";
+        const Loaded l = load(json);
+        PT_CHECK(one_error(l, ConfigError::Syntax, 1, json.find("\"90")), failures);
+        PT_CHECK(l.result.applied == 1 && l.store.get<HighTemperatureAlarm>().threshold != 90.0f, failures);
+    }
+    {
+        const std::string_view json = "{\"TemperatureSetpoint\": 40, \"Temperature";
+        PT_CHECK(one_error(load(json), ConfigError::Syntax, 1, json.rfind('"')), failures);
+    }
+    {
+        const std::string_view json = "{\"zones\": [1, {\"a\": 2}, \n";
+        PT_CHECK(one_error(load(json), ConfigError::Syntax, 1, json.find('[')), failures);
+    }
+    {
+        const std::string_view cases[] = { "", "[]", "{\"TemperatureSetpoint\" 40}", "{\"TemperatureSetpoint\":}",
+                                           "{\"TemperatureSetpoint\": 40 \"HighTemperatureAlarm\": 90}",
+                                           "{TemperatureSetpoint: 40}", "{} {}" };
+        for (std::string_view json : cases)
+        {
+            const Loaded l = load(json);
+            PT_CHECK(l.result.failed == 1 && l.errors.size() == 1 && l.errors[0].error == ConfigError::Syntax, failures);
+        }
+    }
+    return failures;
+}
@@ -0,0 +1,134 @@
+// MappedParameterStore crash safety: a damaged newest slot (block or CRC)
+// falls back to the older generation, a fresh or garbage file starts from
+// the defaults, and commit() refuses a store holding an invalid value.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "mapped_parameter_store.h"
+#include "parameters.h"
+#include "test_support.h"
+
+namespace
+{
+
+using Mapped = MappedParameterStore<Parameters>;
+using Store = ParameterStore<Parameters>;
+
+// Mirrors the file layout: two page-padded slots, header then block.
+constexpr size_t kHeaderSize = sizeof(detail::MappedSlotHeader);
+constexpr size_t kSlotSize = (kHeaderSize + Store::size_bytes + 4095) / 4096 * 4096;
+
+std::vector<unsigned char> read_file(const std::string& path)
+{
+    std::vector<unsigned char> bytes(2 * kSlotSize);
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0 || ::pread(fd, bytes.data(), bytes.size(), 0) != static_cast<ssize_t>(bytes.size())) bytes.clear();
+    if (fd >= 0) ::close(fd);
+    return bytes;
+}
+
+bool write_file(const std::string& path, const std::vector<unsigned char>& bytes)
+{
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    const bool ok = ::write(fd, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size());
+    ::close(fd);
+    return ok;
+}
+
+// Offset of the slot with the higher generation.
+size_t newest_slot(const std::vector<unsigned char>& bytes)
+{
+    detail::MappedSlotHeader a, b;
+    std::memcpy(&a, bytes.data(), sizeof(a));
+    std::memcpy(&b, bytes.data() + kSlotSize, sizeof(b));
+    return b.generation > a.generation ? kSlotSize : 0;
+}
+
+bool starts_at_defaults(const std::string& path)
+{
+    Mapped mapped;
+    return mapped.open(path.c_str())
+        && mapped.generation() == 1
+        && mapped.get<TemperatureSetpoint>().value == ParameterTraits<TemperatureSetpoint>::default_v.value
+        && mapped.get<HighTemperatureAlarm>().threshold == ParameterTraits<HighTemperatureAlarm>::default_v.threshold;
+}
+
+// Commits generations 2 (setpoint 41) and 3 (setpoint 42), damages the
+// newest slot with damage(slot bytes), and expects generation 2 back.
+template <typename Damage>
+size_t falls_back(const std::string& path, Damage&& damage)
+{
+    size_t failures = 0;
+    ::unlink(path.c_str());
+    {
+        Mapped mapped;
+        Store next;
+        PT_CHECK(mapped.open(path.c_str()), failures);
+        PT_CHECK(next.set(TemperatureSetpoint { 41.0f }) && mapped.commit(next), failures);
+        PT_CHECK(next.set(TemperatureSetpoint { 42.0f }) && mapped.commit(next), failures);
+        PT_CHECK(mapped.generation() == 3, failures);
+    }
+
+    std::vector<unsigned char> bytes = read_file(path);
+    PT_CHECK(!bytes.empty(), failures);
+    if (bytes.empty()) return failures;
+    damage(bytes.data() + newest_slot(bytes));
+    PT_CHECK(write_file(path, bytes), failures);
+
+    Mapped mapped;
+    PT_CHECK(mapped.open(path.c_str()), failures);
+    PT_CHECK(mapped.generation() == 2, failures);
+    PT_CHECK(mapped.get<TemperatureSetpoint>().value == 41.0f, failures);
+    return failures;
+}
+
+} // namespace
+
+size_t run_mapped_store_tests()
+{
+    const std::string path = "/tmp/PropertyTraitsTests.params." + std::to_string(::getpid());
+    size_t failures = 0;
+
+    // Newest block changed under its checksum; newest checksum itself wrong.
+    failures += falls_back(path, [](unsigned char* slot) { slot[kHeaderSize] ^= 0x01; });
+    failures += falls_back(path, [](unsigned char* slot)
+    {
+        detail::MappedSlotHeader h;
+        std::memcpy(&h, slot, sizeof(h));
+        h.checksum ^= 0x80000000u;
+        std::memcpy(slot, &h, sizeof(h));
+    });
+
+    // Missing file, then one full of noise.
+    ::unlink(path.c_str());
+    PT_CHECK(starts_at_defaults(path), failures);
+    std::vector<unsigned char> noise(2 * kSlotSize);
+    std::mt19937 rng(11);
+    for (unsigned char& b : noise) b = static_cast<unsigned char>(rng());
+    PT_CHECK(write_file(path, noise), failures);
+    PT_CHECK(starts_at_defaults(path), failures);
+
+    // A value that skipped validate (written through data()) is not committed.
+    {
+        Mapped mapped;
+        Store bad;
+        PT_CHECK(mapped.open(path.c_str()), failures);
+        const float out_of_range = 1e30f;
+        std::memcpy(bad.data() + Store::offset_of<TemperatureSetpoint>(), &out_of_range, sizeof(out_of_range));
+        PT_CHECK(!mapped.commit(bad), failures);
+        PT_CHECK(mapped.generation() == 1, failures);
+        PT_CHECK(mapped.get<TemperatureSetpoint>().value == ParameterTraits<TemperatureSetpoint>::default_v.value, failures);
+    }
+
+    ::unlink(path.c_str());
+    return failures;
+}
@@ -0,0 +1,133 @@
+// SharedParameterBus segment reuse: a writer that dies between making a
+// slot's sequence odd and making it even again must not leave readers
+// spinning, or the next writer's set() publishing under an odd sequence;
+// and a live writer must keep any other process from becoming one.
+// The crash is simulated by editing the segment through a second mapping.
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "parameters.h"
+#include "shared_parameter_bus.h"
+#include "test_support.h"
+
+namespace
+{
+
+using Bus = SharedParameterBus<Parameters>;
+
+// Runs edit(slot sequence, first payload word) on id's slot through a
+// separate read-write mapping of the segment.
+template <typename Edit>
+bool edit_slot(const char* name, ParameterID id, Edit&& edit)
+{
+    const int fd = ::shm_open(name, O_RDWR, 0);
+    if (fd < 0) return false;
+    void* map = ::mmap(nullptr, Bus::segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) return false;
+    unsigned char* slot = static_cast<unsigned char*>(map) + Bus::slot_offsets[static_cast<size_t>(id)];
+    edit(*reinterpret_cast<std::atomic<uint32_t>*>(slot), slot + sizeof(uint64_t));
+    ::munmap(map, Bus::segment_size);
+    return true;
+}
+
+// The writer died mid-write after storing a complete, valid payload.
+size_t interrupted_valid_write(const char* name)
+{
+    size_t failures = 0;
+    {
+        Bus writer;
+        PT_CHECK(writer.create(name), failures);
+        PT_CHECK(writer.set(TemperatureSetpoint { 41.0f }), failures);
+    }
+    PT_CHECK(edit_slot(name, ParameterID::TemperatureSetpoint, [](std::atomic<uint32_t>& seq, unsigned char* payload)
+    {
+        seq.fetch_add(1);
+        const float v = 42.0f;
+        std::memcpy(payload, &v, sizeof(v));
+    }), failures);
+
+    Bus writer;
+    PT_CHECK(writer.create(name), failures);
+    uint32_t version = 0;
+    PT_CHECK(writer.get<TemperatureSetpoint>(&version).value == 42.0f, failures);
+    PT_CHECK(version == 3, failures);    // defaults, 41, the interrupted 42
+
+    PT_CHECK(writer.set(TemperatureSetpoint { 43.0f }), failures);
+    Bus reader;
+    PT_CHECK(reader.attach(name), failures);
+    PT_CHECK(reader.get<TemperatureSetpoint>(&version).value == 43.0f, failures);
+    PT_CHECK(version == 4, failures);
+    return failures;
+}
+
+// The writer died with garbage in the payload: the default comes back.
+size_t interrupted_torn_write(const char* name)
+{
+    size_t failures = 0;
+    PT_CHECK(edit_slot(name, ParameterID::HighTemperatureAlarm, [](std::atomic<uint32_t>& seq, unsigned char* payload)
+    {
+        seq.fetch_add(1);
+        std::memset(payload, 0xFF, sizeof(float));     // NaN
+    }), failures);
+
+    Bus writer;
+    PT_CHECK(writer.create(name), failures);
+    PT_CHECK(writer.get<HighTemperatureAlarm>().threshold == ParameterTraits<HighTemperatureAlarm>::default_v.threshold, failures);
+    PT_CHECK((writer.version(ParameterID::HighTemperatureAlarm) & 1) == 0, failures);
+    return failures;
+}
+
+// A second writer is refused while the first is alive, and admitted after.
+size_t single_writer(const char* name)
+{
+    size_t failures = 0;
+    Bus first;
+    PT_CHECK(first.create(name), failures);
+    PT_CHECK(first.set(TemperatureSetpoint { 44.0f }), failures);
+
+    Bus second;
+    PT_CHECK(!second.create(name), failures);
+    PT_CHECK(errno == EWOULDBLOCK, failures);
+    PT_CHECK(!second.is_open(), failures);
+
+    first.close();
+    PT_CHECK(second.create(name), failures);
+    PT_CHECK(second.get<TemperatureSetpoint>().value == 44.0f, failures);
+    return failures;
+}
+
+size_t read_only_parse(const char* name)
+{
+    size_t failures = 0;
+    Bus reader;
+    PT_CHECK(reader.attach(name), failures);
+    PT_CHECK(reader.parse(ParameterID::TemperatureSetpoint, "50").error == ParameterError::ReadOnly, failures);
+    return failures;
+}
+
+} // namespace
+
+size_t run_shared_bus_tests()
+{
+    const std::string name = "/PropertyTraitsTests." + std::to_string(::getpid());
+    Bus::unlink(name.c_str());
+
+    size_t failures = 0;
+    failures += interrupted_valid_write(name.c_str());
+    failures += interrupted_torn_write(name.c_str());
+    failures += single_writer(name.c_str());
+    failures += read_only_parse(name.c_str());
+
+    Bus::unlink(name.c_str());
+    return failures;
+}
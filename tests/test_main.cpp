@@ -0,0 +1,50 @@
+// Runs one named test group, or all of them: PropertyTraitsTests [group]
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+#include "test_support.h"
+
+namespace
+{
+
+struct TestGroup
+{
+    const char* name;
+    size_t (*run)();
+};
+
+constexpr TestGroup kGroups[] =
+{
+    { "float_format", &run_float_format_tests },
+    { "concurrent_store", &run_concurrent_store_tests },
+    { "shared_bus", &run_shared_bus_tests },
+    { "config_stream", &run_config_stream_tests },
+    { "journal", &run_journal_tests },
+    { "mapped_store", &run_mapped_store_tests },
+    { "float_parse", &run_float_parse_tests },
+    { "json_config", &run_json_config_tests },
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t failures = 0;
+    bool ran = false;
+    for (const TestGroup& g : kGroups)
+    {
+        if (argc > 1 && std::strcmp(argv[1], g.name) != 0) continue;
+        ran = true;
+        const size_t f = g.run();
+        std::cout << g.name << ": " << (f ? "FAILED" : "ok") << " (" << f << " failures)\n";
+        failures += f;
+    }
+    if (!ran)
+    {
+        std::cerr << "unknown test group " << argv[1] << "\n";
+        return 2;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+// Minimal harness for the PropertyTraitsTests executable.
+//
+// Each test group is a function returning its failure count; test_main.cpp
+// maps group names to them so CTest can run every group as its own test:
+//
+//   PropertyTraitsTests float_format
+
+#include <cstddef>
+#include <iostream>
+
+#define PT_CHECK(cond, failures)                                                          \
+    do                                                                                    \
+    {                                                                                     \
+        if (!(cond))                                                                      \
+        {                                                                                 \
+            ++(failures);                                                                 \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #cond "\n";    \
+        }                                                                                 \
+    } while (0)
+
+size_t run_float_format_tests();
+size_t run_concurrent_store_tests();
+size_t run_shared_bus_tests();
+size_t run_config_stream_tests();
+size_t run_journal_tests();
+size_t run_mapped_store_tests();
+size_t run_float_parse_tests();
+size_t run_json_config_tests();
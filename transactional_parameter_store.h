@@ -0,0 +1,182 @@
+#pragma once
+
+// Atomic multi-parameter updates with cross-parameter invariants.
+//
+// TransactionalParameterStore keeps the ParameterStore block as atomic words
+// behind one store-wide seqlock (detail::SeqLockWords). A Transaction stages
+// updates in its own fixed-size copy of the block (each value checked by its
+// trait's validate as it is staged). commit() takes a committers' mutex,
+// overlays the staged values on the current state and runs every registered
+// invariant over the result while readers carry on; only if all pass does it
+// enter the seqlock, for the copy out alone. Readers never lock and never wait
+// on validation: they copy and retry if a publish overlapped, so they can
+// never observe a half-applied transaction.
+
+#include <bitset>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+
+#include "concurrent_parameter_store.h"
+#include "parameter_registry.h"
+#include "parameter_store.h"
+
+template <typename Registry, size_t MaxInvariants = 8>
+class TransactionalParameterStore
+{
+public:
+    using Store = ParameterStore<Registry>;
+
+    // Cross-parameter rule evaluated on the candidate state of a commit.
+    using Invariant = bool (*)(const Store& candidate);
+
+    class Transaction
+    {
+    public:
+        // Stages v if ParameterTraits<T>::validate accepts it.
+        template <typename T>
+        bool set(const T& v)
+        {
+            if (!staged_.set(v)) return false;
+            dirty_.set(static_cast<size_t>(ParameterTraits<T>::id));
+            return true;
+        }
+
+        bool set(ParameterID id, const void* value)
+        {
+            if (!staged_.set(id, value)) return false;
+            dirty_.set(static_cast<size_t>(id));
+            return true;
+        }
+
+        ParameterResult parse(ParameterID id, std::string_view in)
+        {
+            const ParameterResult r = staged_.parse(id, in);
+            if (r) dirty_.set(static_cast<size_t>(id));
+            return r;
+        }
+
+        ParameterResult parse(ParameterID id, const char* in)
+        {
+            return in ? parse(id, std::string_view(in)) : ParameterResult { ParameterError::Empty };
+        }
+
+        // Value as this transaction would commit it.
+        template <typename T>
+        const T& get() const
+        {
+            return staged_.template get<T>();
+        }
+
+        // Publishes every staged value, or none if an invariant fails.
+        bool commit()
+        {
+            const bool ok = owner_.commit(staged_, dirty_);
+            if (ok) dirty_.reset();
+            return ok;
+        }
+
+        // Drops everything staged so far.
+        void abort()
+        {
+            dirty_.reset();
+            owner_.snapshot(staged_);
+        }
+
+    private:
+        friend class TransactionalParameterStore;
+
+        explicit Transaction(TransactionalParameterStore& owner)
+            : owner_(owner)
+        {
+            owner_.snapshot(staged_);
+        }
+
+        TransactionalParameterStore& owner_;
+        Store staged_;
+        std::bitset<Registry::size> dirty_;
+    };
+
+    TransactionalParameterStore()
+    {
+        Store defaults;
+        publish(defaults);
+    }
+
+    // Registers a rule that every commit must satisfy; false once full.
+    // Call during setup, before transactions run concurrently.
+    bool add_invariant(Invariant invariant)
+    {
+        if (invariant_count_ == MaxInvariants) return false;
+        invariants_[invariant_count_++] = invariant;
+        return true;
+    }
+
+    Transaction begin()
+    {
+        return Transaction(*this);
+    }
+
+    template <typename T>
+    T get() const
+    {
+        constexpr size_t offset = Store::template offset_of<T>();
+        constexpr size_t first = offset / kWordSize;
+        constexpr size_t last = (offset + sizeof(T) + kWordSize - 1) / kWordSize;
+        uint64_t buf[last - first];
+        words_.read(buf, first, last);
+        T v;
+        std::memcpy(&v, reinterpret_cast<const unsigned char*>(buf) + offset % kWordSize, sizeof(T));
+        return v;
+    }
+
+    // Consistent copy of every parameter at one commit point.
+    void snapshot(Store& out) const
+    {
+        uint64_t buf[kWords];
+        words_.read(buf);
+        std::memcpy(out.data(), buf, Store::size_bytes);
+    }
+
+private:
+    static constexpr size_t kWordSize = sizeof(uint64_t);
+    static constexpr size_t kWords = Store::size_bytes / kWordSize;
+
+    void publish(const Store& s)
+    {
+        uint64_t buf[kWords];
+        std::memcpy(buf, s.data(), Store::size_bytes);
+        words_.write(buf);
+    }
+
+    bool commit(const Store& staged, const std::bitset<Registry::size>& dirty)
+    {
+        // Only committers wait here; the seqlock stays even meanwhile.
+        std::lock_guard<std::mutex> lock(commit_mutex_);
+
+        // No other commit can publish until we release the mutex, so this
+        // copy stays current while the invariants run.
+        Store candidate;
+        snapshot(candidate);
+        for (size_t i = 0; i < Registry::size; ++i)
+        {
+            if (!dirty.test(i)) continue;
+            const size_t offset = Store::offsets[i];
+            std::memcpy(candidate.data() + offset, staged.data() + offset, Registry::table[i].size);
+        }
+
+        for (size_t i = 0; i < invariant_count_; ++i)
+        {
+            if (!invariants_[i](candidate)) return false;
+        }
+
+        publish(candidate);
+        return true;
+    }
+
+    detail::SeqLockWords<kWords> words_;
+    std::mutex commit_mutex_;
+    Invariant invariants_[MaxInvariants] {};
+    size_t invariant_count_ = 0;
+};